@@ -45,6 +45,7 @@
 
 /* USER CODE BEGIN Includes */
 /* Section where include file can be added */
+#include "dispatcher_mode.h"
 /* USER CODE END Includes */
 
 /* Ensure definitions are only used by the compiler, and not by the assembler. */
@@ -59,7 +60,7 @@
 #define configSUPPORT_STATIC_ALLOCATION          1
 #define configSUPPORT_DYNAMIC_ALLOCATION         1
 #define configUSE_IDLE_HOOK                      0
-#define configUSE_TICK_HOOK                      0
+#define configUSE_TICK_HOOK                      1
 #define configCPU_CLOCK_HZ                       ( SystemCoreClock )
 #define configTICK_RATE_HZ                       ((TickType_t)1000)
 #define configMAX_PRIORITIES                     ( 56 )
@@ -156,6 +157,18 @@ standard names. */
 
 /* USER CODE BEGIN Defines */
 /* Section where parameter definitions can be added (for instance, to override default ones in FreeRTOS.h) */
+/* Count every context switch so the dispatcher can report switches per event. */
+#if defined(__ICCARM__) || defined(__CC_ARM) || defined(__GNUC__)
+extern volatile uint32_t ulContextSwitchCount;
+#endif
+#define traceTASK_SWITCHED_IN() ( ulContextSwitchCount++ )
+/* In DISPATCHER_MODE_DEFERRED the timer service task doubles as the dispatcher, so it
+   must not run below the dispatcher priority. In task mode it keeps the CubeMX value,
+   below the dispatcher, so the dumps pended on it never hold up dispatching. */
+#if DISPATCHER_MODE == DISPATCHER_MODE_DEFERRED
+#undef configTIMER_TASK_PRIORITY
+#define configTIMER_TASK_PRIORITY                ( 5 )
+#endif
 /* USER CODE END Defines */
 
 #endif /* FREERTOS_CONFIG_H */
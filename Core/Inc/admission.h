@@ -0,0 +1,118 @@
+/**
+ * @file admission.h
+ * @brief Header file for the admission controller.
+ *
+ * The dispatcher publishes a saturation level computed from the events in
+ * flight and the number of idle units. The event generator asks the controller what to
+ * do with every new call before posting it: admit it, lower its severity, hold
+ * it back for a while (defer) or shed it. Only low-severity calls are ever
+ * deferred or shed; every decision is counted per reason.
+ *
+ * @date October 15, 2026
+ * @author shayb
+ */
+
+#ifndef INC_ADMISSION_H_
+#define INC_ADMISSION_H_
+
+#include "FreeRTOS.h"
+#include "project_config.h"
+#include <stdint.h>
+
+/**
+ * @brief System saturation level published by the dispatcher.
+ */
+typedef enum
+{
+    SATURATION_NORMAL = 0, // A unit is idle or the backlog is small
+    SATURATION_ELEVATED,   // Backlog above ADMISSION_ELEVATED_PCT of what the departments hold
+    SATURATION_SATURATED,  // Backlog above ADMISSION_SATURATED_PCT
+    SATURATION_OVERLOADED, // Backlog above ADMISSION_OVERLOADED_PCT
+    SATURATION_LEVEL_COUNT
+} SaturationLevel_t;
+
+/**
+ * @brief What the ingress path does with a new call.
+ */
+typedef enum
+{
+    ADMIT_ACCEPT = 0, // Post unchanged
+    ADMIT_DOWNGRADE,  // Post with severity lowered by one level
+    ADMIT_DEFER,      // Hold back and re-evaluate every ADMISSION_DEFER_RETRY_US
+    ADMIT_SHED        // Discard
+} AdmissionAction_t;
+
+/**
+ * @brief Cumulative admission counters (one per decision and reason).
+ */
+typedef struct
+{
+    uint32_t admitted;         /**< Calls posted to the dispatcher. */
+    uint32_t downgraded;       /**< Calls posted with a lowered severity. */
+    uint32_t deferred;         /**< Calls held back at least once. */
+    uint32_t deferAdmitted;    /**< Deferred calls posted later. */
+    uint32_t shedSaturation;   /**< Calls shed by policy because of the saturation level. */
+    uint32_t shedDeferTimeout; /**< Deferred calls shed after ADMISSION_DEFER_MAX_MS. */
+    uint32_t shedDeferFull;    /**< Calls shed because the defer buffer was full. */
+    uint32_t shedQueueFull;    /**< Calls shed because the dispatcher rejected them. */
+    uint32_t shedPoolEmpty;    /**< Calls lost because no event record was free. */
+} AdmissionStats_t;
+
+/**
+ * @brief Counter a shed call is attributed to.
+ */
+typedef enum
+{
+    SHED_SATURATION = 0,
+    SHED_DEFER_TIMEOUT,
+    SHED_DEFER_FULL,
+    SHED_QUEUE_FULL,
+    SHED_POOL_EMPTY
+} ShedReason_t;
+
+/**
+ * @brief Publishes a new saturation level (called by the dispatcher).
+ *
+ * @param total Events in flight system-wide (event pool records in use).
+ * @param capacity Events the system can hold before calls are shed.
+ * @param idleUnits Units idle right now.
+ */
+void Admission_Publish(UBaseType_t total, UBaseType_t capacity, UBaseType_t idleUnits);
+
+/**
+ * @brief Returns the last published saturation level (ISR-safe).
+ */
+SaturationLevel_t Admission_GetLevel(void);
+
+/**
+ * @brief Decides what to do with a new call at the current saturation level (ISR-safe).
+ *
+ * @param severity Severity of the call.
+ * @return Action for the ingress path.
+ */
+AdmissionAction_t Admission_Decide(uint8_t severity);
+
+/**
+ * @brief Records the outcome of an admission decision (ingress path only).
+ *
+ * @param action ADMIT_ACCEPT, ADMIT_DOWNGRADE or ADMIT_DEFER.
+ * @param wasDeferred Non-zero if the call had been deferred before.
+ */
+void Admission_CountAdmit(AdmissionAction_t action, uint8_t wasDeferred);
+
+/**
+ * @brief Records a shed call (ingress path only).
+ */
+void Admission_CountShed(ShedReason_t reason);
+
+/**
+ * @brief Copies the admission counters (task context).
+ */
+void Admission_GetStats(AdmissionStats_t *stats);
+
+/**
+ * @brief Returns a printable name for a saturation level.
+ */
+const char *Admission_LevelName(SaturationLevel_t level);
+
+#endif /* INC_ADMISSION_H_ */
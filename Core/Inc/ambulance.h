@@ -26,6 +26,6 @@
  * @param numUnits The number of ambulance units to initialize.
  * @return pdPASS if initialization is successful, otherwise an error code.
  */
-BaseType_t Ambulance_Init(uint8_t numUnits);
+BaseType_t Ambulance_Init(uint16_t numUnits);
 
 #endif /* INC_AMBULANCE_H_ */
@@ -0,0 +1,80 @@
+/**
+ * @file arrival_model.h
+ * @brief Header file for the event arrival-process models.
+ *
+ * The event generator asks the selected model for the time to the next event.
+ * Every model is reduced to lookup tables when it is initialized, so drawing a
+ * delay costs the same few table reads and multiplies no matter which model is
+ * active or how high the rate is.
+ *
+ * @date October 15, 2026
+ * @author shayb
+ */
+
+#ifndef INC_ARRIVAL_MODEL_H_
+#define INC_ARRIVAL_MODEL_H_
+
+#include "FreeRTOS.h"
+#include "project_config.h"
+#include <stdint.h>
+
+/**
+ * @brief Available arrival processes.
+ */
+typedef enum
+{
+    ARRIVAL_UNIFORM = 0, // Uniform delay in [MIN_EVENT_DELAY_US, MAX_EVENT_DELAY_US] (original behaviour)
+    ARRIVAL_POISSON,     // Exponential delays, mean ARRIVAL_POISSON_MEAN_US
+    ARRIVAL_MMPP,        // Two-state Markov-modulated Poisson process (calm / burst)
+    ARRIVAL_DIURNAL,     // Poisson with an hour-of-day rate curve on a compressed day
+    ARRIVAL_STRESS,      // Poisson at ARRIVAL_STRESS_MEAN_US (thousands of events per second)
+    ARRIVAL_MODEL_COUNT
+} ArrivalModel_t;
+
+/**
+ * @brief Builds the lookup tables and selects ARRIVAL_MODEL.
+ *
+ * Uses floating point; call from task context or before the scheduler starts,
+ * before the event timer is running.
+ */
+void ArrivalModel_Init(void);
+
+/**
+ * @brief Switches the arrival process (takes effect from the next draw).
+ *
+ * @param model Model to use.
+ * @return pdPASS, or pdFAIL if the model is unknown.
+ */
+BaseType_t ArrivalModel_Select(ArrivalModel_t model);
+
+/**
+ * @brief Returns the active arrival process.
+ */
+ArrivalModel_t ArrivalModel_GetActive(void);
+
+/**
+ * @brief Draws the time to the next event (ISR context, constant time).
+ *
+ * @param randomValue Uniform 32-bit random word.
+ * @return Delay in microseconds (at least 1).
+ */
+uint32_t ArrivalModel_NextDelayUsFromISR(uint32_t randomValue);
+
+/**
+ * @brief Draws an exponential delay with the given mean (ISR context, constant time).
+ *
+ * Stateless, so independent sources (districts) can each keep their own rate.
+ * Requires ArrivalModel_Init() to have built the table.
+ *
+ * @param meanUs Mean delay in microseconds.
+ * @param randomValue Uniform 32-bit random word.
+ * @return Delay in microseconds (at least 1).
+ */
+uint32_t ArrivalModel_ExpDelayUsFromISR(uint32_t meanUs, uint32_t randomValue);
+
+/**
+ * @brief Returns a printable name for a model.
+ */
+const char *ArrivalModel_Name(ArrivalModel_t model);
+
+#endif /* INC_ARRIVAL_MODEL_H_ */
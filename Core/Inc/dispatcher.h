@@ -13,6 +13,35 @@
 #define INC_DISPATCHER_H_
 
 #include "FreeRTOS.h"
+#include "project_config.h" // For EventHandle_t
+#include <stdint.h>
+
+/**
+ * @brief Cumulative dispatcher counters.
+ */
+typedef struct
+{
+    uint32_t eventsReceived;  /**< Events taken from the dispatcher input rings. */
+    uint32_t wakeups;         /**< Dispatcher wake-ups (one per batch). */
+    uint32_t contextSwitches; /**< System-wide context switches since boot. */
+    uint32_t parked;          /**< Events parked because their department queue was full. */
+    uint32_t reoffered;       /**< Parked events later delivered to their department. */
+    uint32_t dropped;         /**< Events dropped because the overflow ring was full too. */
+    uint32_t preemptions;     /**< Units interrupted to free them for a more severe call. */
+} DispatcherStats_t;
+
+/**
+ * @def DISPATCHER_NOTIFY_INPUT
+ * @brief Dispatcher notification bit: an input ring went from empty to non-empty.
+ */
+#define DISPATCHER_NOTIFY_INPUT (1UL << 0)
+
+/**
+ * @def DISPATCHER_NOTIFY_DRAIN
+ * @brief Dispatcher notification bit: a department with parked events has drained
+ *        (or any department did while saturated).
+ */
+#define DISPATCHER_NOTIFY_DRAIN (1UL << 1)
 
 /**
  * @brief Initializes the dispatcher module.
@@ -40,4 +69,43 @@ void CreateQueuesAndSemaphores(void);
  */
 void InitializeModules(void);
 
+/**
+ * @brief Copies the current dispatcher counters.
+ *
+ * Context switches per event over an interval can be derived from two
+ * successive snapshots: delta(contextSwitches) / delta(eventsReceived).
+ *
+ * @param stats Destination for the counters.
+ */
+void Dispatcher_GetStats(DispatcherStats_t *stats);
+
+/**
+ * @brief Posts a newly generated event to the dispatcher from an ISR.
+ *
+ * The handle goes into the lock-free SPSC ring of its severity (no critical
+ * section, no copy through the kernel); the consumer drains the rings most
+ * severe first. The consumer, Dispatcher_Task or the timer service task
+ * depending on DISPATCHER_MODE, is only woken when a ring goes from empty to
+ * non-empty.
+ *
+ * @param handle Pool handle of the event.
+ * @param severity Severity of the event.
+ * @param pxHigherPriorityTaskWoken Set to pdTRUE if a context switch is required.
+ * @return pdPASS if the event was accepted, errQUEUE_FULL otherwise (the caller
+ *         still owns the record).
+ */
+BaseType_t Dispatcher_PostFromISR(EventHandle_t handle, uint8_t severity, BaseType_t *pxHigherPriorityTaskWoken);
+
+/**
+ * @brief Tells the dispatcher that a department queue has freed a slot.
+ *
+ * Called by units after taking an event from their department queue. The
+ * dispatcher is only woken if it has events parked for that department, or if
+ * admission control reports saturation (the dispatcher then republishes the
+ * level), so the common case costs two flag tests.
+ *
+ * @param department Department whose queue drained (DepartmentId_t).
+ */
+void Dispatcher_NotifyDrained(uint8_t department);
+
 #endif /* INC_DISPATCHER_H_ */
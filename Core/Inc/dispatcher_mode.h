@@ -0,0 +1,35 @@
+/**
+ * @file dispatcher_mode.h
+ * @brief Dispatcher mode selection (see DISPATCHER_MODE).
+ *
+ * Kept apart from project_config.h because FreeRTOSConfig.h needs it too: the
+ * timer service task priority depends on the mode. Macros only, so it is safe
+ * to include before the kernel headers.
+ *
+ * @date October 16, 2026
+ * @author shayb
+ */
+
+#ifndef INC_DISPATCHER_MODE_H_
+#define INC_DISPATCHER_MODE_H_
+
+/**
+ * @def DISPATCHER_MODE
+ * @brief How events get from the TIM2 ISR to the routing logic.
+ *
+ * In both modes the ISR appends the handle to the lock-free SPSC ring of its
+ * severity.
+ * DISPATCHER_MODE_TASK: Dispatcher_Task is notified when the ring goes
+ * non-empty and routes the events.
+ * DISPATCHER_MODE_DEFERRED: one routing call is pended on the timer service
+ * task (xTimerPendFunctionCallFromISR) instead, which drains everything posted
+ * since. Saves the dispatcher task and its stack, but not time: a wake-up
+ * goes through the timer command queue instead of a task notification, which
+ * costs slightly more (test/host/bench_dispatcher_modes). FreeRTOSConfig.h
+ * raises configTIMER_TASK_PRIORITY above TASK_PRIO_DISPATCHER in this mode only.
+ */
+#define DISPATCHER_MODE_TASK 0
+#define DISPATCHER_MODE_DEFERRED 1
+#define DISPATCHER_MODE DISPATCHER_MODE_TASK
+
+#endif /* INC_DISPATCHER_MODE_H_ */
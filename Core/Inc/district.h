@@ -0,0 +1,71 @@
+/**
+ * @file district.h
+ * @brief Header file for the multi-district event sources.
+ *
+ * The city is split into DISTRICT_COUNT logical event sources, each with its
+ * own arrival rate and event mix. All of them share TIM2: their next arrival
+ * times sit in a binary min-heap, the timer is always armed for the earliest
+ * one, and serving a district and rescheduling it is one O(log N) sift-down.
+ *
+ * With DISTRICT_COUNT = 1 there is a single city-wide source that follows the
+ * selected arrival model and the active event mix (the original behaviour).
+ *
+ * @date October 15, 2026
+ * @author shayb
+ */
+
+#ifndef INC_DISTRICT_H_
+#define INC_DISTRICT_H_
+
+#include "FreeRTOS.h"
+#include "project_config.h" // For DISTRICT_COUNT and TimeStamp_t
+#include <stdint.h>
+
+/**
+ * @def DISTRICT_MAX_COUNT
+ * @brief Upper bound for DISTRICT_COUNT (district IDs are 8-bit).
+ */
+#define DISTRICT_MAX_COUNT 255
+
+#if DISTRICT_COUNT < 1 || DISTRICT_COUNT > DISTRICT_MAX_COUNT
+#error "DISTRICT_COUNT must be between 1 and DISTRICT_MAX_COUNT"
+#endif
+
+/**
+ * @brief Draws every district's first arrival and builds the heap.
+ *
+ * Call from task context after ArrivalModel_Init() and EventMix_Init(),
+ * before the event timer is running. Arrival times start at generator time 0.
+ */
+void District_Init(void);
+
+/**
+ * @brief Returns the district with the earliest pending arrival (ISR context, O(1)).
+ *
+ * @param pDueUs Receives its arrival time in simulated generator microseconds.
+ * @return District ID.
+ */
+uint8_t District_PeekFromISR(TimeStamp_t *pDueUs);
+
+/**
+ * @brief Schedules the next arrival of the district returned by District_PeekFromISR() (ISR context, O(log N)).
+ *
+ * @param randomValue Uniform 32-bit random word for the inter-arrival delay.
+ */
+void District_RescheduleFromISR(uint32_t randomValue);
+
+/**
+ * @brief Draws an event code from a district's mix (ISR context, constant time).
+ *
+ * @param district District ID.
+ * @param randomValue Uniform 32-bit random word.
+ * @return Event code.
+ */
+uint8_t District_NextCodeFromISR(uint8_t district, uint32_t randomValue);
+
+/**
+ * @brief Returns a printable name for a district's profile.
+ */
+const char *District_Name(uint8_t district);
+
+#endif /* INC_DISTRICT_H_ */
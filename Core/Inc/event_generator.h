@@ -14,6 +14,17 @@
 #define INC_EVENT_GENERATOR_H_
 
 #include "FreeRTOS.h"
+#include <stdint.h>
+
+/**
+ * @brief Execution time of the TIM2 generator callback (DWT cycles).
+ */
+typedef struct
+{
+    uint32_t calls;       /**< Timer interrupts handled. */
+    uint64_t totalCycles; /**< Sum of callback execution times. */
+    uint32_t maxCycles;   /**< Longest callback execution. */
+} EventGeneratorIsrStats_t;
 
 /**
  * @brief Initializes the Event Generator module.
@@ -26,4 +37,11 @@
  */
 BaseType_t EventGenerator_Init(void);
 
+/**
+ * @brief Copies the TIM2 callback execution time statistics (task context).
+ *
+ * @param stats Destination for the statistics.
+ */
+void EventGenerator_GetIsrStats(EventGeneratorIsrStats_t *stats);
+
 #endif /* INC_EVENT_GENERATOR_H_ */
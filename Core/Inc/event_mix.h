@@ -0,0 +1,99 @@
+/**
+ * @file event_mix.h
+ * @brief Header file for the weighted event-type distribution.
+ *
+ * The event code of each generated call is drawn from a weighted distribution
+ * over any number of event codes. Distributions are compiled into Walker alias
+ * tables in task context; a draw then costs one random word, the active-table
+ * pointer and one packed table entry, independent of the number of codes.
+ *
+ * Tables are swapped with a single pointer store, so the mix can follow the
+ * district or the time of day without ever stopping the generator.
+ *
+ * @date October 15, 2026
+ * @author shayb
+ */
+
+#ifndef INC_EVENT_MIX_H_
+#define INC_EVENT_MIX_H_
+
+#include "FreeRTOS.h"
+#include "project_config.h"
+#include <stdint.h>
+
+/**
+ * @def EVENT_MIX_MAX_CODES
+ * @brief Maximum number of event codes in one distribution.
+ */
+#define EVENT_MIX_MAX_CODES 16
+
+/**
+ * @brief Relative weight of one event code.
+ */
+typedef struct
+{
+    uint8_t eventCode; /**< EVENT_CODE_* value. */
+    uint16_t weight;   /**< Relative weight (0 = never drawn). */
+} EventMixWeight_t;
+
+/**
+ * @brief Compiled alias table.
+ *
+ * Each entry packs the acceptance threshold (bits 31..16, out of 65536), the
+ * alias code (bits 15..8) and the column's own code (bits 7..0).
+ */
+typedef struct
+{
+    uint32_t count;                         /**< Number of columns. */
+    uint32_t entries[EVENT_MIX_MAX_CODES];  /**< Packed columns. */
+} EventMixTable_t;
+
+/**
+ * @brief Builds the default mix (EVENT_MIX_WEIGHT_*) and makes it active.
+ *
+ * Call before the event timer is running.
+ */
+void EventMix_Init(void);
+
+/**
+ * @brief Compiles a weighted distribution into an alias table (task context).
+ *
+ * The table must not be the active one while it is being rebuilt.
+ *
+ * @param table Destination table.
+ * @param weights Event codes and their weights.
+ * @param count Number of entries in @p weights (1..EVENT_MIX_MAX_CODES).
+ * @return pdPASS, or pdFAIL if the count is out of range or all weights are zero.
+ */
+BaseType_t EventMix_Build(EventMixTable_t *table, const EventMixWeight_t *weights, uint8_t count);
+
+/**
+ * @brief Makes a compiled table the active mix (atomic swap).
+ *
+ * The ISR reads the table pointer once per draw and cannot be preempted by a
+ * task, so the previous table is free for reuse as soon as this returns.
+ *
+ * @param table Table built by EventMix_Build().
+ * @return The previously active table.
+ */
+const EventMixTable_t *EventMix_Activate(const EventMixTable_t *table);
+
+/**
+ * @brief Draws an event code from a given table (any context, constant time).
+ *
+ * @param table Table built by EventMix_Build().
+ * @param randomValue Uniform 32-bit random word (see EventMix_NextCodeFromISR()).
+ * @return Event code.
+ */
+uint8_t EventMix_DrawFromTable(const EventMixTable_t *table, uint32_t randomValue);
+
+/**
+ * @brief Draws an event code from the active mix (ISR context, constant time).
+ *
+ * @param randomValue Uniform 32-bit random word: the upper half picks the
+ *                    column, the lower half flips the biased coin.
+ * @return Event code.
+ */
+uint8_t EventMix_NextCodeFromISR(uint32_t randomValue);
+
+#endif /* INC_EVENT_MIX_H_ */
@@ -0,0 +1,92 @@
+/**
+ * @file event_pool.h
+ * @brief Header file for the fixed-capacity event pool.
+ *
+ * Event records are allocated once from a static pool and referenced by small
+ * integer handles. Queues only carry the handle, so passing an event from the
+ * generator ISR to the dispatcher, a department and finally a unit never copies
+ * the record itself. The unit that finishes an event releases it.
+ *
+ * @date October 15, 2026
+ * @author shayb
+ */
+
+#ifndef INC_EVENT_POOL_H_
+#define INC_EVENT_POOL_H_
+
+#include "FreeRTOS.h"
+#include "project_config.h" // For EmergencyEvent_t, EventHandle_t, EVENT_POOL_SIZE
+
+/**
+ * @def EVENT_HANDLE_INVALID
+ * @brief Returned by the allocators when the pool is exhausted.
+ */
+#define EVENT_HANDLE_INVALID ((EventHandle_t)0xFF)
+
+#if EVENT_POOL_SIZE >= 0xFF
+#error "EVENT_POOL_SIZE must be below 255 (8-bit handles, 0xFF is reserved)"
+#endif
+
+/**
+ * @def EVENT_POOL_REQUIRED
+ * @brief Events that can be in flight at once: every queue slot, every unit,
+ *        the dispatcher's batch and the generator's defer buffer.
+ */
+#define EVENT_POOL_REQUIRED                                                              \
+    ((NUM_SEVERITY_LEVELS * DISPATCHER_RING_LENGTH) +                                    \
+     (POLICE_DEPT_QUEUE_LENGTH + AMBULANCE_DEPT_QUEUE_LENGTH + FIRE_DEPT_QUEUE_LENGTH) + \
+     (DEPT_COUNT * OVERFLOW_RING_LENGTH) +                                               \
+     (RESOURCES_POLICE + RESOURCES_AMBULANCE + RESOURCES_FIRE_DEPT) +                    \
+     DISPATCHER_BATCH_SIZE + ADMISSION_DEFER_SLOTS)
+
+_Static_assert(EVENT_POOL_SIZE >= EVENT_POOL_REQUIRED, "EVENT_POOL_SIZE must cover every queue, unit and buffer that can hold an event");
+
+/**
+ * @brief Initializes the pool, marking every record free.
+ *
+ * Must be called before any task or ISR allocates events.
+ */
+void EventPool_Init(void);
+
+/**
+ * @brief Allocates an event record from task context.
+ *
+ * @return Handle of the record, or EVENT_HANDLE_INVALID if the pool is empty.
+ */
+EventHandle_t EventPool_Alloc(void);
+
+/**
+ * @brief Allocates an event record from ISR context.
+ *
+ * @return Handle of the record, or EVENT_HANDLE_INVALID if the pool is empty.
+ */
+EventHandle_t EventPool_AllocFromISR(void);
+
+/**
+ * @brief Returns a record to the pool (task context).
+ *
+ * @param handle Handle obtained from EventPool_Alloc / EventPool_AllocFromISR.
+ */
+void EventPool_Release(EventHandle_t handle);
+
+/**
+ * @brief Returns a record to the pool (ISR context).
+ *
+ * @param handle Handle obtained from EventPool_Alloc / EventPool_AllocFromISR.
+ */
+void EventPool_ReleaseFromISR(EventHandle_t handle);
+
+/**
+ * @brief Resolves a handle to its event record.
+ *
+ * @param handle Valid, allocated handle.
+ * @return Pointer to the record (owned by whoever holds the handle).
+ */
+EmergencyEvent_t *EventPool_Get(EventHandle_t handle);
+
+/**
+ * @brief Returns the number of free records (lock-free snapshot).
+ */
+UBaseType_t EventPool_FreeCount(void);
+
+#endif /* INC_EVENT_POOL_H_ */
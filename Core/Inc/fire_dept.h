@@ -26,6 +26,6 @@
  * @param numUnits The number of fire department units to initialize.
  * @return pdPASS if initialization is successful, otherwise an error code.
  */
-BaseType_t FireDept_Init(uint8_t numUnits);
+BaseType_t FireDept_Init(uint16_t numUnits);
 
 #endif /* INC_FIRE_DEPT_H_ */
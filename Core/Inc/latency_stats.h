@@ -0,0 +1,97 @@
+/**
+ * @file latency_stats.h
+ * @brief Header file for the per-department latency histograms.
+ *
+ * Every completed event contributes its per-stage and end-to-end latencies to
+ * fixed-size log2 histograms (one set per department). Memory use is fixed at
+ * build time; recording is O(1).
+ *
+ * Critical calls are also recorded, across departments, in one of two more
+ * sets depending on whether pre-emption was enabled when they were handed off,
+ * so its effect on the calls it is meant for can be compared.
+ *
+ * @date October 15, 2026
+ * @author shayb
+ */
+
+#ifndef INC_LATENCY_STATS_H_
+#define INC_LATENCY_STATS_H_
+
+#include "FreeRTOS.h"
+#include "project_config.h"
+#include <stdint.h>
+
+/**
+ * @brief Measured intervals between event stages.
+ */
+typedef enum
+{
+    LATENCY_DISPATCH = 0, // Generated -> taken in by the dispatcher
+    LATENCY_ROUTE,        // Dispatcher -> handed to a unit or queued (not recorded for re-queued calls)
+    LATENCY_QUEUE,        // Queued (last time, if re-queued) -> picked up by a unit
+    LATENCY_SERVICE,      // Picked up -> completed
+    LATENCY_END_TO_END,   // Generated -> completed
+    LATENCY_RESPONSE,     // Generated -> unit on scene
+    LATENCY_INTERVAL_COUNT
+} LatencyInterval_t;
+
+/**
+ * @brief One log2 latency histogram.
+ */
+typedef struct
+{
+    uint32_t buckets[LATENCY_HIST_BUCKETS]; /**< Bucket N counts [2^(N-1), 2^N) us. */
+    uint32_t count;                         /**< Samples recorded. */
+    uint32_t maxUs;                         /**< Largest sample. */
+} LatencyHistogram_t;
+
+/**
+ * @brief Records the latencies of a completed event.
+ *
+ * @param department Department that served the event (DepartmentId_t).
+ * @param event Event with all stage stamps filled in.
+ */
+void LatencyStats_Record(uint8_t department, const EmergencyEvent_t *event);
+
+/**
+ * @brief Copies one histogram.
+ *
+ * @param department Department (DepartmentId_t).
+ * @param interval Interval (LatencyInterval_t).
+ * @param hist Destination.
+ */
+void LatencyStats_Get(uint8_t department, uint8_t interval, LatencyHistogram_t *hist);
+
+/**
+ * @brief Copies one critical-call histogram (EVENT_SEVERITY_CRITICAL, all departments).
+ *
+ * @param preemption 1 for calls handed off with pre-emption enabled, 0 without.
+ * @param interval Interval (LatencyInterval_t).
+ * @param hist Destination.
+ */
+void LatencyStats_GetCritical(uint8_t preemption, uint8_t interval, LatencyHistogram_t *hist);
+
+/**
+ * @brief Returns the upper bound (us) of the bucket holding the given percentile.
+ *
+ * @param hist Histogram.
+ * @param percent Percentile, 1..100.
+ * @return Upper bound of the bucket, or 0 if the histogram is empty.
+ */
+uint32_t LatencyStats_Percentile(const LatencyHistogram_t *hist, uint8_t percent);
+
+/**
+ * @brief Logs a summary (count, p50, p90, p99, max) of every non-empty histogram.
+ *
+ * Task context; see LatencyStats_RequestDumpFromISR() for the push-button path.
+ */
+void LatencyStats_Dump(void);
+
+/**
+ * @brief Schedules LatencyStats_Dump() on the timer service task (ISR-safe).
+ *
+ * @param pxHigherPriorityTaskWoken Set to pdTRUE if a context switch is required.
+ */
+void LatencyStats_RequestDumpFromISR(BaseType_t *pxHigherPriorityTaskWoken);
+
+#endif /* INC_LATENCY_STATS_H_ */
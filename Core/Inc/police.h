@@ -23,6 +23,6 @@
  * @param numUnits The number of police units to initialize.
  * @return pdPASS if initialization is successful, otherwise an error code.
  */
-BaseType_t Police_Init(uint8_t numUnits);
+BaseType_t Police_Init(uint16_t numUnits);
 
 #endif /* INC_POLICE_H_ */
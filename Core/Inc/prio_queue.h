@@ -0,0 +1,93 @@
+/**
+ * @file prio_queue.h
+ * @brief Header file for the bounded multi-level priority queue module.
+ *
+ * The priority queue is a drop-in replacement for a FreeRTOS queue where items
+ * carry a priority level. Items of the same level are served FIFO, and the
+ * highest non-empty level is always served first. A bitmap of non-empty levels
+ * makes both insert and pop O(1) regardless of the current backlog, so the
+ * queueing delay of a top-level item does not grow with the number of
+ * lower-level items waiting behind it.
+ *
+ * @date October 15, 2026
+ * @author shayb
+ */
+
+#ifndef INC_PRIO_QUEUE_H_
+#define INC_PRIO_QUEUE_H_
+
+#include "FreeRTOS.h"
+#include <stdint.h>
+
+/**
+ * @def PRIO_QUEUE_MAX_LEVELS
+ * @brief Maximum number of priority levels (one bit per level in the bitmap).
+ */
+#define PRIO_QUEUE_MAX_LEVELS 8
+
+/**
+ * @def PRIO_QUEUE_MAX_LENGTH
+ * @brief Maximum number of items a single priority queue can hold.
+ *
+ * Slots are linked with 8-bit indices; 0xFF is reserved as the end marker.
+ */
+#define PRIO_QUEUE_MAX_LENGTH 254
+
+/**
+ * @brief Opaque priority queue type (defined in prio_queue.c).
+ */
+typedef struct PrioQueue PrioQueue_t;
+
+/**
+ * @brief Handle used to reference a priority queue.
+ */
+typedef PrioQueue_t *PrioQueueHandle_t;
+
+/**
+ * @brief Creates a new priority queue.
+ *
+ * Allocates the queue, its item storage and its blocking semaphores from the
+ * FreeRTOS heap.
+ *
+ * @param uxLength Maximum number of items the queue can hold (all levels combined).
+ * @param uxItemSize Size of one item in bytes.
+ * @return Handle to the new queue, or NULL if allocation failed.
+ */
+PrioQueueHandle_t PrioQueue_Create(UBaseType_t uxLength, UBaseType_t uxItemSize);
+
+/**
+ * @brief Posts an item to the back of its priority level.
+ *
+ * @param xQueue Queue handle.
+ * @param pvItem Pointer to the item to copy into the queue.
+ * @param uxLevel Priority level (higher value is served first). Values above
+ *                PRIO_QUEUE_MAX_LEVELS - 1 are clamped.
+ * @param xTicksToWait Maximum time to block waiting for space.
+ * @return pdPASS if the item was posted, errQUEUE_FULL otherwise.
+ */
+BaseType_t PrioQueue_Send(PrioQueueHandle_t xQueue, const void *pvItem, UBaseType_t uxLevel, TickType_t xTicksToWait);
+
+/**
+ * @brief Receives the oldest item of the highest non-empty priority level.
+ *
+ * @param xQueue Queue handle.
+ * @param pvBuffer Buffer the item is copied into.
+ * @param xTicksToWait Maximum time to block waiting for an item.
+ * @return pdPASS if an item was received, errQUEUE_EMPTY otherwise.
+ */
+BaseType_t PrioQueue_Receive(PrioQueueHandle_t xQueue, void *pvBuffer, TickType_t xTicksToWait);
+
+/**
+ * @brief Returns the number of items currently stored in the queue.
+ *
+ * Lock-free read of the item counter; callers that need a consistent view of
+ * several queues can wrap a series of reads in one critical section.
+ */
+UBaseType_t PrioQueue_MessagesWaiting(PrioQueueHandle_t xQueue);
+
+/**
+ * @brief Returns the number of free slots in the queue (lock-free, see above).
+ */
+UBaseType_t PrioQueue_SpacesAvailable(PrioQueueHandle_t xQueue);
+
+#endif /* INC_PRIO_QUEUE_H_ */
@@ -20,13 +20,22 @@
 #include "main.h"
 #include "stm32f7xx_hal.h"
 
-// --- Event Generation ---
+// --- Simulation Time ---
 /**
- * @def EVENT_TIMER_TICK_MS
- * @brief Timer interrupt frequency in milliseconds.
+ * @def SIM_TIME_DILATION
+ * @brief Simulated seconds per wall-clock second (1 = real time).
+ *
+ * Applied by the generator timer and the unit service delays; event stamps and
+ * latency statistics are kept in simulated time. Unit phases run in whole RTOS
+ * ticks of wall time, i.e. in steps of SIM_TIME_DILATION ms of simulated time;
+ * a mission is rounded as a whole, so its length is right on average. Up to 60
+ * (a simulated day in 24 minutes) department saturation matches the 1x run
+ * (test/host/test_time_dilation.c). Can be changed at runtime with
+ * TimeBase_SetDilation().
  */
-#define EVENT_TIMER_TICK_MS 10 // Timer interrupt frequency
+#define SIM_TIME_DILATION 1
 
+// --- Event Generation ---
 /**
  * @def MIN_EVENT_DELAY_MS
  * @brief Minimum delay between events in milliseconds.
@@ -39,24 +48,60 @@
  */
 #define MAX_EVENT_DELAY_MS 5000 // Maximum delay between events (5 seconds)
 
-// Calculate ticks based on timer period
 /**
- * @def MIN_EVENT_DELAY_TICKS
- * @brief Minimum delay between events in timer ticks.
+ * @def EVENT_TIMER_CLOCK_HZ
+ * @brief Count rate of the one-shot event timer (TIM2): 1 us resolution.
+ *
+ * TIM2 is re-armed for the exact next arrival, so it interrupts once per event
+ * (32-bit counter: delays up to ~71 minutes).
+ */
+#define EVENT_TIMER_CLOCK_HZ 1000000UL
+
+/**
+ * @def MIN_EVENT_DELAY_US
+ * @brief Minimum delay between events in microseconds (may be set below 1 ms for stress tests).
+ */
+#define MIN_EVENT_DELAY_US (MIN_EVENT_DELAY_MS * 1000UL)
+
+/**
+ * @def MAX_EVENT_DELAY_US
+ * @brief Maximum delay between events in microseconds.
  */
-#define MIN_EVENT_DELAY_TICKS (MIN_EVENT_DELAY_MS / EVENT_TIMER_TICK_MS)
+#define MAX_EVENT_DELAY_US (MAX_EVENT_DELAY_MS * 1000UL)
 
 /**
- * @def MAX_EVENT_DELAY_TICKS
- * @brief Maximum delay between events in timer ticks.
+ * @def DELAY_RANGE_US
+ * @brief Range of delay in microseconds.
  */
-#define MAX_EVENT_DELAY_TICKS (MAX_EVENT_DELAY_MS / EVENT_TIMER_TICK_MS)
+#define DELAY_RANGE_US (MAX_EVENT_DELAY_US - MIN_EVENT_DELAY_US + 1UL)
 
+// --- Arrival Models (see arrival_model.h) ---
 /**
- * @def DELAY_RANGE_TICKS
- * @brief Range of delay in timer ticks.
+ * @def ARRIVAL_MODEL
+ * @brief Arrival process selected at boot (ArrivalModel_t); can be changed at run time.
  */
-#define DELAY_RANGE_TICKS (MAX_EVENT_DELAY_TICKS - MIN_EVENT_DELAY_TICKS + 1)
+#define ARRIVAL_MODEL ARRIVAL_UNIFORM
+
+#define ARRIVAL_POISSON_MEAN_US 3000000UL // Poisson: mean delay (~0.33 events/s)
+
+#define ARRIVAL_MMPP_CALM_MEAN_US 4000000UL // MMPP: mean delay in the calm state
+#define ARRIVAL_MMPP_BURST_MEAN_US 200000UL // MMPP: mean delay during a burst
+#define ARRIVAL_MMPP_ENTER_BURST_P256 13    // MMPP: chance per event (x/256) of a burst starting
+#define ARRIVAL_MMPP_LEAVE_BURST_P256 51    // MMPP: chance per event (x/256) of a burst ending (~5 events)
+
+#define ARRIVAL_DIURNAL_MEAN_US 3000000UL  // Diurnal: mean delay over the whole day
+#define ARRIVAL_DIURNAL_HOUR_US 10000000UL // Diurnal: length of a simulated hour (4 min day)
+
+#define ARRIVAL_STRESS_MEAN_US 250UL // Stress: mean delay (~4000 events/s)
+
+// --- Trace Replay / Recording (see trace.h) ---
+/**
+ * @def TRACE_REPLAY_ENABLE
+ * @brief 1 = inject the calls of the flash trace (trace_data.c) instead of random ones.
+ */
+#define TRACE_REPLAY_ENABLE 0
+#define TRACE_REPLAY_LOOP 0          // 1 = restart the trace when it ends, 0 = stop generating
+#define TRACE_RECORDER_CAPACITY 512  // Records the recorder can hold (4 bytes each: one per call, plus one per 67 s of silence before it)
 
 // --- Event Codes ---
 /**
@@ -77,20 +122,292 @@
  */
 #define EVENT_CODE_FIRE_DEPT 3 // Code for Fire Department event
 
+/**
+ * @def EVENT_CODE_COUNT
+ * @brief Size of tables indexed by event code (codes start at 1, index 0 is unused).
+ */
+#define EVENT_CODE_COUNT (EVENT_CODE_FIRE_DEPT + 1)
+
+// --- Districts (see district.h) ---
+/**
+ * @def DISTRICT_COUNT
+ * @brief Number of independent event sources (districts) sharing the event timer.
+ *
+ * 1 = one city-wide source driven by ARRIVAL_MODEL and the active event mix.
+ * Above 1, each district is a Poisson source with the rate and mix of its
+ * profile in district.c (up to DISTRICT_MAX_COUNT).
+ */
+#define DISTRICT_COUNT 1
+
+// --- Event Mix (see event_mix.h) ---
+/**
+ * @def EVENT_MIX_WEIGHT_POLICE
+ * @brief Relative weight of each event code in the default call mix.
+ *
+ * Only the ratios matter. Equal weights reproduce the original 1/3 split.
+ */
+#define EVENT_MIX_WEIGHT_POLICE 1
+#define EVENT_MIX_WEIGHT_AMBULANCE 1
+#define EVENT_MIX_WEIGHT_FIRE_DEPT 1
+
+// --- Event Severity ---
+// Higher value = more urgent. Severity is the priority level used by the dispatcher
+// and department priority queues, so the top level is always served first.
+#define EVENT_SEVERITY_LOW 0      // e.g. noise complaint
+#define EVENT_SEVERITY_MEDIUM 1   // e.g. minor injury, theft in progress
+#define EVENT_SEVERITY_HIGH 2     // e.g. structure fire, serious injury
+#define EVENT_SEVERITY_CRITICAL 3 // e.g. cardiac arrest, life-threatening
+#define NUM_SEVERITY_LEVELS 4     // Must not exceed PRIO_QUEUE_MAX_LEVELS
+
+// --- Departments ---
+/**
+ * @brief Department identifiers, used to index per-department tables.
+ */
+typedef enum
+{
+    DEPT_POLICE = 0,
+    DEPT_AMBULANCE,
+    DEPT_FIRE,
+    DEPT_COUNT // Number of departments (keep last)
+} DepartmentId_t;
+
 // --- Department Resource Counts ---
 #define RESOURCES_AMBULANCE 4 // Number of available ambulances
 #define RESOURCES_POLICE 3    // Number of available police cars
 #define RESOURCES_FIRE_DEPT 2 // Number of available fire trucks
 
+/**
+ * @def UNIT_MODEL
+ * @brief How department units are simulated.
+ *
+ * UNIT_MODEL_TASK: one FreeRTOS task per unit (1 KB of stack each, at most
+ * MAX_UNITS_PER_DEPT units per department).
+ * UNIT_MODEL_SCHEDULER: one scheduler task per department; each unit costs
+ * 102 bytes of heap (record, accounting, state word, idle-stack slot) and its
+ * phases run on the timing wheel, so a department can field hundreds of units
+ * (up to MAX_SCHEDULED_UNITS_PER_DEPT).
+ */
+#define UNIT_MODEL_TASK 0
+#define UNIT_MODEL_SCHEDULER 1
+#define UNIT_MODEL UNIT_MODEL_TASK
+
 // --- Task Simulation Timing ---
-// Example: Define min/max task execution time in *timer ticks*
-// Adjust based on EVENT_TIMER_TICK_MS
-#define MIN_TASK_DURATION_TICKS (200 / EVENT_TIMER_TICK_MS)  // Example: 200 ms
-#define MAX_TASK_DURATION_TICKS (1500 / EVENT_TIMER_TICK_MS) // Example: 1500 ms
+// Min/max task execution time in milliseconds (converted with TimeBase_MsToTicks)
+#define MIN_TASK_DURATION_MS 200  // Example: 200 ms
+#define MAX_TASK_DURATION_MS 1500 // Example: 1500 ms
+
+/**
+ * @def SERVICE_TIME_MODEL
+ * @brief How unit service times are drawn.
+ *
+ * SERVICE_TIME_UNIFORM: uniform between MIN/MAX_TASK_DURATION_MS (original behaviour).
+ * SERVICE_TIME_TABLE: per-department distribution from the build-time inverse-CDF
+ * tables (see service_time.h and tools/gen_service_time_tables.py).
+ */
+#define SERVICE_TIME_UNIFORM 0
+#define SERVICE_TIME_TABLE 1
+#define SERVICE_TIME_MODEL SERVICE_TIME_TABLE
+
+// --- Dispatcher Overflow Handling ---
+/**
+ * @def OVERFLOW_RING_LENGTH
+ * @brief Events the dispatcher can park per department while that department's queue is full.
+ *
+ * Parked events are re-offered as soon as a unit drains the department queue;
+ * only when this ring is also full is an event dropped.
+ */
+#define OVERFLOW_RING_LENGTH 16
+
+// --- Admission Control ---
+/**
+ * @def ADMISSION_ELEVATED_PCT
+ * @brief Events in flight, in percent of what the departments can hold
+ *        (queues, parked slots, units), at which low-severity calls are deferred.
+ *
+ * The saturation level only rises above normal while no unit is idle.
+ */
+#define ADMISSION_ELEVATED_PCT 50
+#define ADMISSION_SATURATED_PCT 75  // Low severity shed, medium deferred
+#define ADMISSION_OVERLOADED_PCT 90 // Low severity shed, medium downgraded
+
+/**
+ * @def ADMISSION_DEFER_SLOTS
+ * @brief Calls the generator can hold back at once; further deferrals are shed.
+ */
+#define ADMISSION_DEFER_SLOTS 4
+
+/**
+ * @def ADMISSION_DEFER_MAX_MS
+ * @brief Longest a call is held back before it is shed.
+ */
+#define ADMISSION_DEFER_MAX_MS 3000
+#define ADMISSION_DEFER_MAX_US (ADMISSION_DEFER_MAX_MS * 1000UL)
+
+/**
+ * @def ADMISSION_DEFER_RETRY_US
+ * @brief Interval at which deferred calls are re-evaluated while any are held.
+ */
+#define ADMISSION_DEFER_RETRY_US 10000UL
+
+// --- Random Number Service ---
+/**
+ * @def RNG_RING_LENGTH
+ * @brief Random words prefetched by the RNG interrupt (power of two).
+ */
+#define RNG_RING_LENGTH 32
+
+/**
+ * @def RNG_SERVICE_MODE
+ * @brief How the RNG service obtains its words.
+ *
+ * RNG_SERVICE_RING: prefetched by the RNG interrupt, served in constant time.
+ * RNG_SERVICE_POLLED: measurement mode. Every word busy-waits on
+ * HAL_RNG_GenerateRandomNumber, as the generator ISR did before the ring, so
+ * the "TIM2 ISR" stats line gives the cost without the ring for comparison.
+ */
+#define RNG_SERVICE_RING 0
+#define RNG_SERVICE_POLLED 1
+#define RNG_SERVICE_MODE RNG_SERVICE_RING
+
+// --- Latency Statistics ---
+/**
+ * @def LATENCY_HIST_BUCKETS
+ * @brief Log2 buckets per latency histogram.
+ *
+ * Bucket 0 counts 0 us, bucket N counts [2^(N-1), 2^N) us; the last bucket also
+ * takes everything longer (26 buckets reach ~33 s).
+ */
+#define LATENCY_HIST_BUCKETS 26
+
+/**
+ * @def USER_BTN_LOCKOUT_MS
+ * @brief Time after a USER_Btn press during which further edges are ignored.
+ *
+ * The button bounces for a few milliseconds, and every rising edge raises the
+ * EXTI interrupt; without the lockout one press requests several dumps.
+ */
+#define USER_BTN_LOCKOUT_MS 250
+
+// --- Load-Aware Redirection ---
+/**
+ * @def REDIRECT_WAIT_MARGIN_MS
+ * @brief Minimum expected-wait advantage (ms) an alternative department needs
+ *        over the primary before an event is redirected to it.
+ */
+#define REDIRECT_WAIT_MARGIN_MS 200
+
+/**
+ * @def UNIT_NEARLY_FREE_MS
+ * @brief A busy unit that clears its call within this time (simulated ms)
+ *        counts as about to be free: a call queued for it now waits no longer
+ *        than this, so routing treats it like an idle unit.
+ */
+#define UNIT_NEARLY_FREE_MS 300
+
+/**
+ * @def PREEMPTION_MODE
+ * @brief Whether a call may interrupt a unit that is serving a less severe one.
+ *
+ * PREEMPTION_OFF: a unit always finishes its call.
+ * PREEMPTION_ON: a call of PREEMPT_MIN_SEVERITY or above that finds no idle
+ * unit is queued and interrupts the unit serving the least severe call (turning
+ * out, en route or on scene). That call goes back to the department queue with
+ * the on-scene work already done, and the unit takes the most severe queued call.
+ * PREEMPTION_AB: measurement mode. As PREEMPTION_ON, but a software timer
+ * switches it off and on every PREEMPTION_AB_PERIOD_MS, so one run reports
+ * critical-call latency with and without it.
+ */
+#define PREEMPTION_OFF 0
+#define PREEMPTION_ON 1
+#define PREEMPTION_AB 2
+#define PREEMPTION_MODE PREEMPTION_ON
+#define PREEMPTION_AB_PERIOD_MS 10000 // Time with each setting in PREEMPTION_AB (wall clock)
+
+/**
+ * @def PREEMPT_MIN_SEVERITY
+ * @brief Lowest severity that may pre-empt a unit (the victim's call must be less severe).
+ */
+#define PREEMPT_MIN_SEVERITY EVENT_SEVERITY_CRITICAL
+
+/**
+ * @def SERVICE_TIME_EWMA_SHIFT
+ * @brief Weight of the running mean service time: each new sample counts 1/2^N.
+ */
+#define SERVICE_TIME_EWMA_SHIFT 3
 
 // --- Queue Configuration ---
-#define DISPATCHER_QUEUE_LENGTH 20                          // Max number of events waiting for dispatcher
-#define DISPATCHER_QUEUE_ITEM_SIZE sizeof(EmergencyEvent_t) // Size of one event message
+#define DISPATCHER_RING_LENGTH 32                           // Events waiting for the dispatcher, per severity level (power of two)
+#define DISPATCHER_QUEUE_ITEM_SIZE sizeof(EventHandle_t)    // Queues carry event pool handles, not events
+
+// --- Event Pool ---
+/**
+ * @def EVENT_POOL_SIZE
+ * @brief Number of event records in the pool (events in flight, system-wide).
+ *
+ * Must cover every queue plus the events being served by units, so that a call
+ * is only ever shed by admission control or a full queue, never by an empty
+ * pool (checked in event_pool.h against EVENT_POOL_REQUIRED, 227 with the
+ * values here). Handles are 8-bit, so the maximum is 254 (0xFF is
+ * EVENT_HANDLE_INVALID).
+ */
+#define EVENT_POOL_SIZE 240
+
+// --- Dispatcher Batching ---
+/**
+ * @def DISPATCHER_BATCH_SIZE
+ * @brief Maximum number of events the dispatcher drains per wake-up.
+ *
+ * All events of a batch are routed against one occupancy snapshot. Set to 1 to
+ * dispatch one event per wake-up.
+ */
+#define DISPATCHER_BATCH_SIZE 8
+
+#include "dispatcher_mode.h" // DISPATCHER_MODE (shared with FreeRTOSConfig.h)
+
+/**
+ * @brief Points in an event's life at which it is time-stamped.
+ */
+typedef enum
+{
+    EVENT_STAGE_GENERATED = 0, // Created in the generator ISR
+    EVENT_STAGE_DISPATCHED,    // Taken in by the dispatcher
+    EVENT_STAGE_ENQUEUED,      // Handed to a unit or queued in its department
+    EVENT_STAGE_PICKED_UP,     // A unit started on it
+    EVENT_STAGE_ON_SCENE,      // The unit arrived at the incident
+    EVENT_STAGE_COMPLETED,     // The unit cleared it (left the scene or the hospital)
+    EVENT_STAGE_COUNT
+} EventStage_t;
+
+/**
+ * @brief Time stamp: microseconds since boot on the 64-bit system clock (see time_base.h).
+ */
+typedef uint64_t TimeStamp_t;
+
+/**
+ * @def DISPATCHER_STATS_LOG_PERIOD_MS
+ * @brief Period of the dispatcher statistics log line (events, wake-ups, context switches).
+ */
+#define DISPATCHER_STATS_LOG_PERIOD_MS 10000
+
+// --- Utilization Accounting ---
+/**
+ * @def UTILIZATION_WINDOW_MS
+ * @brief Length (simulated ms) of one window of the rolling department utilization.
+ */
+#define UTILIZATION_WINDOW_MS 5000
+
+/**
+ * @def UTILIZATION_WINDOW_COUNT
+ * @brief Windows kept for the rolling utilization (it covers the last
+ *        UTILIZATION_WINDOW_COUNT - 1 full windows plus the current one).
+ */
+#define UTILIZATION_WINDOW_COUNT 12
+
+/**
+ * @def UTILIZATION_SATURATION_PCT
+ * @brief Rolling busy share (%) at which a department is reported as saturating.
+ */
+#define UTILIZATION_SATURATION_PCT 85
 
 // Define queue lengths for individual departments if they queue pending calls
 #define POLICE_DEPT_QUEUE_LENGTH 10
@@ -114,9 +431,23 @@
 // --- Common Data Structures ---
 typedef struct
 {
-    uint8_t eventCode;    // 1=Police, 2=Ambulance, 3=Fire Dept.
-    TickType_t timeStamp; // Track when event was generated
-    //    uint8_t priority;
+    uint8_t eventCode;                       // 1=Police, 2=Ambulance, 3=Fire Dept.
+    uint8_t severity;                        // EVENT_SEVERITY_* (priority level in the queues)
+    uint8_t district;                        // District the call came from (see district.h)
+    TickType_t timeStamp;                    // Track when event was generated
+    TimeStamp_t stamps[EVENT_STAGE_COUNT];   // When the event reached each stage (see time_base.h)
+    uint32_t sceneUs;                        // On-scene work the incident needs (simulated us, 0 = not planned yet)
+    uint32_t sceneDoneUs;                    // On-scene work done by units that were pre-empted
+    uint8_t preemption;                      // Pre-emption enabled when it was handed off (latency stats split)
+    uint8_t requeues;                        // Times a pre-empted unit handed the call back
 } EmergencyEvent_t;
 
+/**
+ * @brief Handle of an EmergencyEvent_t record in the event pool (see event_pool.h).
+ *
+ * Only handles travel through the queues, so queue items stay one byte no
+ * matter how large the event record grows.
+ */
+typedef uint8_t EventHandle_t;
+
 #endif /* INC_PROJECT_CONFIG_H_ */
@@ -12,8 +12,11 @@
 #ifndef INC_RESOURCE_TASK_H_
 #define INC_RESOURCE_TASK_H_
 
-#include "FreeRTOS.h" // For QueueHandle_t
-#include "queue.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "prio_queue.h" // For PrioQueueHandle_t
+#include "project_config.h"
+#include "utilization.h" // For UnitUtilization_t
 
 /**
  * @brief Task Parameter Structure for resource tasks.
@@ -23,18 +26,140 @@
  */
 typedef struct
 {
-    QueueHandle_t xDepartmentQueue; /**< Handle of the SHARED queue this task reads from. */
-    uint8_t departmentType;         /**< Type of the department (e.g., police, fire, ambulance). */
+    PrioQueueHandle_t xDepartmentQueue; /**< Handle of the SHARED queue this task reads from. */
+    uint8_t departmentType;         /**< Type of the department (DepartmentId_t). */
+    uint8_t unitIndex;              /**< Index of the unit within its department (bit in the idle mask). */
 } ResourceTaskParams_t;
 
+/**
+ * @def MAX_UNITS_PER_DEPT
+ * @brief Maximum number of units per department (one bit each in the idle mask).
+ */
+#define MAX_UNITS_PER_DEPT 32
+
+/**
+ * @def MAX_SCHEDULED_UNITS_PER_DEPT
+ * @brief Maximum number of units per department in UNIT_MODEL_SCHEDULER (16-bit unit indices).
+ */
+#define MAX_SCHEDULED_UNITS_PER_DEPT 1024
+
+/**
+ * @brief Outcome of ResourceUnit_HandOff().
+ */
+typedef enum
+{
+    HANDOFF_TO_UNIT = 0, // Notified an idle unit directly (no queue involved)
+    HANDOFF_QUEUED,      // Every unit busy, event queued in the shared department queue
+    HANDOFF_PREEMPTED,   // Event queued and a unit on a less severe call told to take it
+    HANDOFF_REJECTED     // Every unit busy and the department queue is full
+} HandOffResult_t;
+
+/**
+ * @brief Snapshot of a department's units, used by the dispatcher's load model.
+ */
+typedef struct
+{
+    uint32_t idleMask;         /**< Bit N set while unit N is idle (UNIT_MODEL_TASK only, else 0). */
+    uint16_t idleUnits;        /**< Units idle and waiting for a direct hand-off. */
+    uint16_t numUnits;         /**< Units that have started and registered. */
+    uint32_t meanServiceTicks; /**< Running mean time a unit is committed to a call (RTOS ticks). */
+} DeptUnitStatus_t;
+
+/**
+ * @brief Result of ResourceUnit_ScanUnits().
+ */
+typedef struct
+{
+    uint16_t nearlyFreeUnits;   /**< Busy units that clear their call within UNIT_NEARLY_FREE_MS. */
+    uint32_t soonestClearTicks; /**< Simulated ticks until the first busy unit clears its call (0 if none is busy). */
+} UnitScan_t;
+
 /**
  * @brief Get a random task duration in ticks.
  *
- * This helper function generates a random duration in ticks for resource tasks.
+ * This helper function generates a random duration in ticks for resource tasks,
+ * from the department's service-time distribution (see SERVICE_TIME_MODEL).
  *
+ * @param department Department the unit belongs to (DepartmentId_t).
  * @return Random duration in ticks.
  */
-uint32_t GetRandomTaskDurationTicks(void);
+uint32_t GetRandomTaskDurationTicks(uint8_t department);
+
+/**
+ * @brief Hands an event to a department without blocking.
+ *
+ * If a unit of the department is idle, the lowest-latency path is taken: the
+ * unit is claimed in the idle mask (found with CLZ in O(1)) and receives the
+ * event handle through its task notification, skipping the queue entirely.
+ * In UNIT_MODEL_SCHEDULER the claim is a decrement of the idle count and the
+ * handle goes to the department's scheduler task instead.
+ * Only when every unit is busy is the event put in the shared queue.
+ *
+ * With pre-emption enabled, a call of PREEMPT_MIN_SEVERITY or above that is
+ * queued also interrupts the busy unit serving the least severe call below it
+ * (a scan of at most MAX_UNITS_PER_DEPT units; an O(1) index lookup in
+ * UNIT_MODEL_SCHEDULER). The queue keeps a slot for every interrupted call until its
+ * unit has handed it back, so a pre-emption never loses a call.
+ *
+ * @param department Department identifier (DepartmentId_t).
+ * @param xQueue Shared queue of that department.
+ * @param handle Event pool handle.
+ * @param severity Severity of the event (priority level in the queue).
+ * @return Where the event went (see HandOffResult_t).
+ */
+HandOffResult_t ResourceUnit_HandOff(uint8_t department, PrioQueueHandle_t xQueue, EventHandle_t handle, uint8_t severity);
+
+/**
+ * @brief Enables or disables pre-emption at run time (see PREEMPTION_MODE).
+ *
+ * Units already told to hand back their call still do so.
+ */
+void ResourceUnit_SetPreemption(BaseType_t xEnabled);
+
+/**
+ * @brief Returns pdTRUE while pre-emption is enabled.
+ */
+BaseType_t ResourceUnit_GetPreemption(void);
+
+/**
+ * @brief Reads the unit status of a department (lock-free, word-sized reads).
+ *
+ * @param department Department identifier (DepartmentId_t).
+ * @param status Destination for the snapshot.
+ */
+void ResourceUnit_GetStatus(uint8_t department, DeptUnitStatus_t *status);
+
+/**
+ * @brief Scans a department's unit state array (lock-free, O(units)).
+ *
+ * Finds the units that are about to clear their call, i.e. that will take the
+ * next queued call almost at once.
+ *
+ * @param department Department identifier (DepartmentId_t).
+ * @param scan Destination for the result.
+ */
+void ResourceUnit_ScanUnits(uint8_t department, UnitScan_t *scan);
+
+/**
+ * @brief Returns a department's shared unit state array (see unit_lifecycle.h).
+ *
+ * Each entry is one word written atomically by its unit; readers need no lock.
+ *
+ * @param department Department identifier (DepartmentId_t).
+ * @param pNumUnits Set to the number of valid entries.
+ * @return The state words, indexed by unit.
+ */
+const volatile uint32_t *ResourceUnit_GetUnitStates(uint8_t department, uint16_t *pNumUnits);
+
+/**
+ * @brief Reads the time accounting of one unit (see utilization.h), without stopping it.
+ *
+ * @param department Department identifier (DepartmentId_t).
+ * @param unit Unit index within the department.
+ * @param out Destination.
+ * @return pdPASS, or pdFAIL if the unit does not exist.
+ */
+BaseType_t ResourceUnit_GetUtilization(uint8_t department, uint16_t unit, UnitUtilization_t *out);
 
 /**
  * @brief Generic Resource Unit Task function.
@@ -46,4 +171,21 @@ uint32_t GetRandomTaskDurationTicks(void);
  */
 void ResourceUnit_Task(void *pvParameters);
 
+/**
+ * @brief Creates the scheduler task that simulates all units of a department
+ *        (UNIT_MODEL_SCHEDULER).
+ *
+ * Units are records of a few bytes kept in one heap block, so several hundred
+ * units cost less RAM than a single unit task. Dispatch semantics are the same
+ * as with one task per unit: idle units get calls directly, busy departments
+ * queue them and free units take the most severe queued call first.
+ *
+ * @param department Department identifier (DepartmentId_t).
+ * @param xQueue Shared queue of that department.
+ * @param numUnits Number of units (1..MAX_SCHEDULED_UNITS_PER_DEPT).
+ * @param name Task name, also used as the unit name prefix in the log.
+ * @return pdPASS, or pdFAIL if the memory or the task could not be allocated.
+ */
+BaseType_t ResourceUnit_CreateScheduler(uint8_t department, PrioQueueHandle_t xQueue, uint16_t numUnits, const char *name);
+
 #endif /* INC_RESOURCE_TASK_H_ */
@@ -0,0 +1,52 @@
+/**
+ * @file rng_service.h
+ * @brief Header file for the non-blocking random number service.
+ *
+ * A ring of random words is refilled in the background by the RNG data-ready
+ * interrupt. Consumers (the generator ISR, unit tasks) take one word in
+ * constant time and never wait on the peripheral. If the ring is empty or the
+ * RNG has failed, a seeded xorshift generator answers instead.
+ *
+ * @date October 15, 2026
+ * @author shayb
+ */
+
+#ifndef INC_RNG_SERVICE_H_
+#define INC_RNG_SERVICE_H_
+
+#include "FreeRTOS.h"
+#include <stdint.h>
+
+/**
+ * @brief Cumulative RNG service counters.
+ */
+typedef struct
+{
+    uint32_t hardwareWords; /**< Words served from the hardware ring. */
+    uint32_t fallbackWords; /**< Words served by the xorshift fallback. */
+    uint32_t hardwareErrors; /**< RNG seed or clock errors reported by the peripheral. */
+} RngServiceStats_t;
+
+/**
+ * @brief Seeds the fallback generator and starts the background refill.
+ *
+ * Call after MX_RNG_Init() and TimeBase_Init(), before the generator timer starts.
+ */
+void RngService_Init(void);
+
+/**
+ * @brief Returns a random word (task context, constant time).
+ */
+uint32_t RngService_Next(void);
+
+/**
+ * @brief Returns a random word (ISR context, constant time).
+ */
+uint32_t RngService_NextFromISR(void);
+
+/**
+ * @brief Copies the service counters (task context).
+ */
+void RngService_GetStats(RngServiceStats_t *stats);
+
+#endif /* INC_RNG_SERVICE_H_ */
@@ -0,0 +1,107 @@
+/**
+ * @file routing_table.h
+ * @brief Header file for the table-driven routing engine.
+ *
+ * Routing rules live in a const table (flash) indexed by event code. Each entry
+ * is an ordered list of hops: hop 0 is the primary department, the following
+ * hops are fallbacks. Every hop carries its own redirect policy, which decides
+ * whether the hop accepts the event given a snapshot of department load.
+ * A routing decision is therefore one indexed load plus a short scan.
+ *
+ * New event types and fallback chains are added in routing_table.c only.
+ *
+ * @date October 15, 2026
+ * @author shayb
+ */
+
+#ifndef INC_ROUTING_TABLE_H_
+#define INC_ROUTING_TABLE_H_
+
+#include "project_config.h"
+#include <stdint.h>
+
+/**
+ * @brief Condition under which a hop accepts an event.
+ */
+typedef enum
+{
+    REDIRECT_IF_SPACE = 0,    // Accept if a unit is idle or the department queue has a free slot
+    REDIRECT_IF_IDLE,         // Accept only if the department has no backlog at all
+    REDIRECT_IF_UNIT_IDLE,    // Accept only if a unit can take the event (almost) immediately
+    REDIRECT_IF_SHORTER_WAIT, // Accept if the expected wait beats the primary's by REDIRECT_WAIT_MARGIN_MS
+    REDIRECT_ALWAYS           // Accept unconditionally (wait here if needed)
+} RedirectPolicy_t;
+
+/**
+ * @brief One hop of a routing chain.
+ */
+typedef struct
+{
+    uint8_t department; /**< DepartmentId_t of this hop. */
+    uint8_t policy;     /**< RedirectPolicy_t applied to this hop. */
+} RouteHop_t;
+
+/**
+ * @brief Routing rule for one event code.
+ */
+typedef struct
+{
+    const RouteHop_t *hops; /**< Ordered hops; hops[0] is the primary department. */
+    uint8_t numHops;        /**< Number of hops (0 = event code not routable). */
+} RouteEntry_t;
+
+/**
+ * @brief Snapshot of one department's queue occupancy used for routing decisions.
+ */
+typedef struct
+{
+    UBaseType_t freeSlots;     /**< Free slots in the department queue. */
+    UBaseType_t queued;        /**< Events waiting in the department queue. */
+    UBaseType_t idleUnits;     /**< Units idle and waiting for a direct hand-off. */
+    UBaseType_t numUnits;      /**< Units staffing the department. */
+    uint32_t meanServiceTicks; /**< Running mean service time per call (RTOS ticks). */
+    UBaseType_t nearlyFreeUnits; /**< Busy units about to clear their call (UNIT_NEARLY_FREE_MS). */
+    uint32_t soonestClearTicks;  /**< Ticks until the first busy unit clears its call. */
+} DeptLoad_t;
+
+/**
+ * @brief Looks up the routing rule for an event code.
+ *
+ * @param eventCode Event code (EVENT_CODE_*).
+ * @return Pointer to the const rule, or NULL if the code has no route.
+ */
+const RouteEntry_t *Routing_Lookup(uint8_t eventCode);
+
+/**
+ * @brief Selects the hop that should receive an event.
+ *
+ * Scans the hops in order and returns the first one whose policy accepts the
+ * event under the given load snapshot. If no hop accepts, the primary (hop 0)
+ * is returned so the event waits in its own department.
+ *
+ * @param route Routing rule returned by Routing_Lookup().
+ * @param load Per-department load snapshot, indexed by DepartmentId_t.
+ * @return Index of the selected hop within route->hops.
+ */
+uint8_t Routing_SelectHop(const RouteEntry_t *route, const DeptLoad_t load[DEPT_COUNT]);
+
+/**
+ * @brief Estimates how long a new event would wait before a unit starts on it.
+ *
+ * Zero if a unit is idle. With nothing queued, the wait is exactly the time
+ * until the first busy unit clears its call (from the unit state array).
+ * Otherwise every busy unit frees up on average every meanServiceTicks, so with
+ * N units one frees up every mean/N, and the new event needs (queued + 1) of
+ * those releases: wait = mean * (queued + 1) / N.
+ *
+ * @param load Load snapshot of the department.
+ * @return Expected wait in RTOS ticks.
+ */
+uint32_t Routing_EstimatedWaitTicks(const DeptLoad_t *load);
+
+/**
+ * @brief Returns a printable name for a department.
+ */
+const char *Routing_DeptName(uint8_t department);
+
+#endif /* INC_ROUTING_TABLE_H_ */
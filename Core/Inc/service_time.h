@@ -0,0 +1,56 @@
+/**
+ * @file service_time.h
+ * @brief Header file for the per-department service-time distributions.
+ *
+ * Each department draws its on-scene time from its own distribution (lognormal,
+ * gamma or empirical). The distributions are reduced at build time to
+ * fixed-point inverse-CDF tables (tools/gen_service_time_tables.py), so a draw
+ * is one random word, one table lookup and one linear interpolation.
+ *
+ * @date October 15, 2026
+ * @author shayb
+ */
+
+#ifndef INC_SERVICE_TIME_H_
+#define INC_SERVICE_TIME_H_
+
+#include "project_config.h" // For DEPT_COUNT
+#include <stdint.h>
+
+/**
+ * @def SERVICE_TIME_TABLE_BITS
+ * @brief Random bits that select the table interval (the generator must match).
+ */
+#define SERVICE_TIME_TABLE_BITS 8
+#define SERVICE_TIME_TABLE_SIZE (1U << SERVICE_TIME_TABLE_BITS)
+
+/**
+ * @brief Service-time distribution of one department.
+ */
+typedef struct
+{
+    const uint32_t *quantileMs; /**< Quantile at u = i / SIZE, i = 0..SIZE, in milliseconds. */
+    const char *name;           /**< Distribution family, for logging. */
+    uint32_t meanMs;            /**< Mean of the tabulated distribution. */
+} ServiceTimeTable_t;
+
+/**
+ * @brief Tables indexed by DepartmentId_t (generated at build time).
+ */
+extern const ServiceTimeTable_t serviceTimeTables[DEPT_COUNT];
+
+/**
+ * @brief Draws a service time for a department.
+ *
+ * @param department Department (DepartmentId_t).
+ * @param randomValue Uniform 32-bit random word.
+ * @return Service time in milliseconds (at least 1).
+ */
+uint32_t ServiceTime_DrawMs(uint8_t department, uint32_t randomValue);
+
+/**
+ * @brief Returns the distribution family of a department, for logging.
+ */
+const char *ServiceTime_Name(uint8_t department);
+
+#endif /* INC_SERVICE_TIME_H_ */
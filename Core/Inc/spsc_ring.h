@@ -0,0 +1,81 @@
+/**
+ * @file spsc_ring.h
+ * @brief Header file for the lock-free single-producer/single-consumer ring.
+ *
+ * Carries event handles from one interrupt (the producer) to one task (the
+ * consumer) without critical sections or kernel calls. Each side owns one
+ * free-running index: the producer only writes tail, the consumer only writes
+ * head, so neither side ever has to mask interrupts. Memory barriers order the
+ * slot accesses against the index updates.
+ *
+ * The producer learns whether the ring was empty when it published, so the
+ * consumer only needs to be woken on the empty -> non-empty transition.
+ *
+ * @date October 15, 2026
+ * @author shayb
+ */
+
+#ifndef INC_SPSC_RING_H_
+#define INC_SPSC_RING_H_
+
+#include "FreeRTOS.h"
+#include "project_config.h" // For EventHandle_t
+#include <stdint.h>
+
+/**
+ * @brief Ring control block. Storage is supplied by the owner.
+ */
+typedef struct
+{
+    EventHandle_t *items;   /**< Slot storage (length is a power of two). */
+    uint32_t mask;          /**< Length - 1, maps a free-running index to a slot. */
+    volatile uint32_t head; /**< Next slot to read; written by the consumer only. */
+    volatile uint32_t tail; /**< Next slot to write; written by the producer only. */
+    uint32_t tailSeen;      /**< Last tail the consumer read; consumer only. */
+} SpscRing_t;
+
+/**
+ * @brief Initializes an empty ring over caller-provided storage.
+ *
+ * @param ring Ring to initialize.
+ * @param storage Slot array of @p length entries.
+ * @param length Number of slots, must be a power of two.
+ * @return pdPASS, or pdFAIL if the length is not a power of two.
+ */
+BaseType_t SpscRing_Init(SpscRing_t *ring, EventHandle_t *storage, uint32_t length);
+
+/**
+ * @brief Appends a handle (producer side, usually an ISR).
+ *
+ * @param ring Ring to append to.
+ * @param handle Handle to store.
+ * @param pxWasEmpty Set to pdTRUE if the consumer had drained everything
+ *                   before this handle was published, i.e. it may be asleep
+ *                   and must be woken. May be NULL.
+ * @return pdPASS if stored, errQUEUE_FULL if the ring is full.
+ */
+BaseType_t SpscRing_Push(SpscRing_t *ring, EventHandle_t handle, BaseType_t *pxWasEmpty);
+
+/**
+ * @brief Removes the oldest handle (consumer side).
+ *
+ * @param ring Ring to read from.
+ * @param pHandle Destination for the handle.
+ * @return pdPASS if a handle was removed, errQUEUE_EMPTY otherwise.
+ */
+BaseType_t SpscRing_Pop(SpscRing_t *ring, EventHandle_t *pHandle);
+
+/**
+ * @brief Returns the number of stored handles (a snapshot, safe from either side).
+ */
+uint32_t SpscRing_Count(const SpscRing_t *ring);
+
+/**
+ * @brief Returns the capacity of the ring in handles.
+ */
+static inline uint32_t SpscRing_Length(const SpscRing_t *ring)
+{
+    return ring->mask + 1U;
+}
+
+#endif /* INC_SPSC_RING_H_ */
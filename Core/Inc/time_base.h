@@ -0,0 +1,132 @@
+/**
+ * @file time_base.h
+ * @brief Header file for the system time base.
+ *
+ * One monotonic 64-bit clock in microseconds serves every module: event stamps,
+ * latency statistics, service times and the generator. It is derived from the
+ * Cortex-M7 DWT cycle counter and extended past the counter's 32-bit wrap with
+ * the RTOS tick count, so it never wraps in practice (~584,000 years).
+ *
+ * Conversions between microseconds, milliseconds and RTOS ticks go through the
+ * helpers below rather than ad hoc arithmetic, so every duration carries its
+ * unit in its name.
+ *
+ * For accelerated runs a simulated clock runs SIM_TIME_DILATION times faster
+ * than the wall clock. The simulation (arrivals, service times, event stamps,
+ * latency statistics) lives entirely in simulated time; only the points that
+ * actually wait on hardware (the generator timer, vTaskDelay) convert to wall
+ * time.
+ *
+ * @date October 15, 2026
+ * @author shayb
+ */
+
+#ifndef INC_TIME_BASE_H_
+#define INC_TIME_BASE_H_
+
+#include "FreeRTOS.h"
+#include "project_config.h" // For TimeStamp_t
+#include <stdint.h>
+
+#define TIME_US_PER_MS 1000U
+#define TIME_US_PER_TICK (1000000U / configTICK_RATE_HZ)
+
+/**
+ * @brief Enables and zeroes the DWT cycle counter.
+ *
+ * Call once after the system clock is configured, before any time stamp is taken.
+ */
+void TimeBase_Init(void);
+
+/**
+ * @brief Returns the time since TimeBase_Init() in microseconds.
+ *
+ * Safe from tasks and from ISRs at or below configMAX_SYSCALL_INTERRUPT_PRIORITY.
+ * Successive calls never go backwards.
+ */
+TimeStamp_t TimeBase_NowUs(void);
+
+/**
+ * @brief Returns the simulated time since TimeBase_Init() in microseconds.
+ *
+ * Equal to TimeBase_NowUs() at a dilation of 1. Same context rules, and stays
+ * monotonic across TimeBase_SetDilation().
+ */
+TimeStamp_t TimeBase_SimNowUs(void);
+
+/**
+ * @brief Changes the time-dilation factor.
+ *
+ * The simulated clock is rebased so it continues from its current value.
+ *
+ * @param factor Simulated seconds per wall-clock second (>= 1).
+ * @return pdPASS, or pdFAIL if the factor is zero.
+ */
+BaseType_t TimeBase_SetDilation(uint32_t factor);
+
+/**
+ * @brief Returns the time-dilation factor.
+ */
+uint32_t TimeBase_GetDilation(void);
+
+/**
+ * @brief Converts a simulated duration in microseconds to wall-clock microseconds, rounding up.
+ */
+uint64_t TimeBase_SimToWallUs(uint64_t simUs);
+
+/**
+ * @brief Converts a simulated duration in RTOS ticks to wall-clock ticks, rounding up (at least 1).
+ */
+TickType_t TimeBase_SimToWallTicks(TickType_t simTicks);
+
+/**
+ * @brief Returns the time between two stamps in microseconds.
+ *
+ * @param from Earlier stamp.
+ * @param to Later stamp.
+ * @return Elapsed microseconds (0 if @p to precedes @p from), saturated at UINT32_MAX.
+ */
+static inline uint32_t TimeBase_ElapsedUs(TimeStamp_t from, TimeStamp_t to)
+{
+    if (to <= from)
+    {
+        return 0;
+    }
+    return ((to - from) > UINT32_MAX) ? UINT32_MAX : (uint32_t)(to - from);
+}
+
+// --- Unit Conversions ---
+
+/**
+ * @brief Converts milliseconds to RTOS ticks, rounding up so a delay is never shortened.
+ */
+static inline TickType_t TimeBase_MsToTicks(uint32_t ms)
+{
+    return (TickType_t)(((uint64_t)ms * TIME_US_PER_MS + TIME_US_PER_TICK - 1U) / TIME_US_PER_TICK);
+}
+
+/**
+ * @brief Converts microseconds to RTOS ticks, rounding up.
+ */
+static inline TickType_t TimeBase_UsToTicks(uint64_t us)
+{
+    return (TickType_t)((us + TIME_US_PER_TICK - 1U) / TIME_US_PER_TICK);
+}
+
+/**
+ * @brief Converts RTOS ticks to microseconds.
+ */
+static inline uint64_t TimeBase_TicksToUs(TickType_t ticks)
+{
+    return (uint64_t)ticks * TIME_US_PER_TICK;
+}
+
+/**
+ * @brief Converts RTOS ticks to milliseconds (truncated).
+ */
+static inline uint32_t TimeBase_TicksToMs(TickType_t ticks)
+{
+    return (uint32_t)(((uint64_t)ticks * TIME_US_PER_TICK) / TIME_US_PER_MS);
+}
+
+#endif /* INC_TIME_BASE_H_ */
@@ -0,0 +1,107 @@
+/**
+ * @file timer_wheel.h
+ * @brief Header file for the hierarchical timing wheel (unit mission timers).
+ *
+ * Busy units no longer sit in the kernel's delayed list (sorted, O(n) insert)
+ * while they serve a call. Each mission phase is a TimerWheelTimer_t instead,
+ * kept in a three-level hierarchical timing wheel advanced by the FreeRTOS tick
+ * hook:
+ *
+ *   level 0: 256 slots of 1 tick      (0 .. 255 ticks ahead)
+ *   level 1:  64 slots of 256 ticks   (up to 16.4 s ahead at 1 kHz)
+ *   level 2:  64 slots of 16384 ticks (up to 17.5 min ahead)
+ *
+ * Starting and stopping a timer is an O(1) list link/unlink. Each tick visits
+ * one level-0 slot; every 256 ticks one level-1 slot (and every 16384 ticks one
+ * level-2 slot) is cascaded into the level below, so a timer is moved at most
+ * twice in its life. Delays beyond the top level are parked in its farthest
+ * slot and re-filed when that slot comes round. Timers are intrusive: the
+ * wheel allocates nothing and supports any number of them.
+ *
+ * The callback runs in the tick interrupt and must only use FromISR APIs.
+ *
+ * @date October 15, 2026
+ * @author shayb
+ */
+
+#ifndef INC_TIMER_WHEEL_H_
+#define INC_TIMER_WHEEL_H_
+
+#include "FreeRTOS.h"
+#include <stdint.h>
+
+#define TIMER_WHEEL_L0_BITS 8 // Slots of the tick level
+#define TIMER_WHEEL_LN_BITS 6 // Slots of each upper level
+#define TIMER_WHEEL_LEVELS 3
+
+typedef struct TimerWheelTimer TimerWheelTimer_t;
+
+/**
+ * @brief Expiry callback, called from the tick interrupt.
+ *
+ * The timer is already inactive, so it may be restarted from the callback with
+ * TimerWheel_StartFromISR(). Until then its list link is free for the owner's
+ * use (e.g. to queue the expired timer for a task).
+ */
+typedef void (*TimerWheelCallback_t)(TimerWheelTimer_t *timer, BaseType_t *pxHigherPriorityTaskWoken);
+
+/**
+ * @brief One timer. Storage is supplied by the owner (usually embedded in its record).
+ */
+struct TimerWheelTimer
+{
+    TimerWheelTimer_t *next;        /**< Next timer in the slot list. */
+    TimerWheelTimer_t **pprev;      /**< Link pointing at this timer, NULL while inactive. */
+    TickType_t expiry;              /**< Wheel tick at which the timer fires. */
+    TimerWheelCallback_t callback;  /**< Called on expiry (ISR context). */
+    void *context;                  /**< Owner data for the callback. */
+};
+
+/**
+ * @brief Prepares an inactive timer.
+ *
+ * @param timer Timer to initialize.
+ * @param callback Expiry callback.
+ * @param context Owner data, available to the callback as timer->context.
+ */
+void TimerWheel_InitTimer(TimerWheelTimer_t *timer, TimerWheelCallback_t callback, void *context);
+
+/**
+ * @brief Starts (or restarts) a timer, O(1), task context.
+ *
+ * @param timer Initialized timer.
+ * @param delayTicks Ticks from now; 0 fires on the next tick.
+ */
+void TimerWheel_Start(TimerWheelTimer_t *timer, TickType_t delayTicks);
+
+/**
+ * @brief ISR version of TimerWheel_Start() (also usable from an expiry callback).
+ */
+void TimerWheel_StartFromISR(TimerWheelTimer_t *timer, TickType_t delayTicks);
+
+/**
+ * @brief Cancels a timer, O(1), task context.
+ *
+ * @param timer Timer to cancel.
+ * @return pdTRUE if the timer was cancelled before it fired, pdFALSE if it was
+ *         not running (already fired, or never started). When pdTRUE is
+ *         returned the callback is guaranteed not to run.
+ */
+BaseType_t TimerWheel_Stop(TimerWheelTimer_t *timer);
+
+/**
+ * @brief Ticks left until a running timer fires (0 if it is not running).
+ */
+TickType_t TimerWheel_Remaining(const TimerWheelTimer_t *timer);
+
+/**
+ * @brief Advances the wheel by one tick and fires the timers that are due.
+ *
+ * Called from vApplicationTickHook(), once per RTOS tick.
+ *
+ * @param pxHigherPriorityTaskWoken Set to pdTRUE if a callback woke a task
+ *                                  that should run next.
+ */
+void TimerWheel_TickFromISR(BaseType_t *pxHigherPriorityTaskWoken);
+
+#endif /* INC_TIMER_WHEEL_H_ */
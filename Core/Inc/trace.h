@@ -0,0 +1,125 @@
+/**
+ * @file trace.h
+ * @brief Header file for incident trace replay and recording.
+ *
+ * A trace is a compact, timestamped list of calls. Replay injects the calls with
+ * the recorded timing instead of drawing random ones, so different builds can be
+ * compared against identical input. The recorder captures a live run in the
+ * same format.
+ *
+ * Image layout (32-bit little-endian words):
+ *   [0] TRACE_MAGIC  [1] TRACE_VERSION  [2] record count  [3..] records
+ *
+ * Record word:
+ *   bits 31..6  delay since the previous record, in microseconds (max ~67 s)
+ *   bits  5..4  reserved (0)
+ *   bits  3..2  event code (EVENT_CODE_*), 0 = gap record (delay only, no call)
+ *   bits  1..0  severity (EVENT_SEVERITY_*)
+ *
+ * On target the replayed image is a const table in flash (trace_data.c). The
+ * recorder dumps its image as hex words over the log, ready to be pasted back
+ * into trace_data.c or saved as a binary file for a host build.
+ *
+ * @date October 15, 2026
+ * @author shayb
+ */
+
+#ifndef INC_TRACE_H_
+#define INC_TRACE_H_
+
+#include "FreeRTOS.h"
+#include "project_config.h"
+#include <stddef.h>
+#include <stdint.h>
+
+#define TRACE_MAGIC 0x54444543UL // "CEDT" in little-endian byte order
+#define TRACE_VERSION 1UL
+#define TRACE_HEADER_WORDS 3U
+#define TRACE_MAX_DELAY_US 0x03FFFFFFUL // 26-bit delay field
+
+/**
+ * @def TRACE_RECORD
+ * @brief Encodes one record word.
+ */
+#define TRACE_RECORD(delayUs, code, severity) \
+    ((((uint32_t)(delayUs)) << 6) | (((uint32_t)(code) & 0x3U) << 2) | ((uint32_t)(severity) & 0x3U))
+
+#define TRACE_RECORD_DELAY_US(word) ((word) >> 6)
+#define TRACE_RECORD_CODE(word) (((word) >> 2) & 0x3U)
+#define TRACE_RECORD_SEVERITY(word) ((word) & 0x3U)
+
+#if EVENT_CODE_COUNT > 4 || NUM_SEVERITY_LEVELS > 4
+#error "Trace records hold 2-bit event codes and severities"
+#endif
+
+/**
+ * @brief Flash-resident trace replayed when TRACE_REPLAY_ENABLE is set (trace_data.c).
+ */
+extern const uint32_t traceFlashImage[];
+extern const size_t traceFlashImageWords;
+
+/**
+ * @brief Validates a trace image and makes it the replay source.
+ *
+ * @param image Start of the image (must stay valid while replaying).
+ * @param lengthBytes Size of the image in bytes.
+ * @return pdPASS if the image is valid, pdFAIL otherwise.
+ */
+BaseType_t TraceReplay_Load(const uint32_t *image, size_t lengthBytes);
+
+#if defined(TRACE_HOST_BUILD)
+/**
+ * @brief Memory-maps a trace file and loads it (host builds only).
+ *
+ * @param path Path of a binary trace image.
+ * @return pdPASS if the file was mapped and is valid, pdFAIL otherwise.
+ */
+BaseType_t TraceReplay_LoadFile(const char *path);
+#endif
+
+/**
+ * @brief Returns pdTRUE while a loaded trace still has calls to inject.
+ */
+BaseType_t TraceReplay_IsActive(void);
+
+/**
+ * @brief Takes the next call from the trace (ISR context).
+ *
+ * Gap records are folded into the returned delay.
+ *
+ * @param delayUs Delay before the call, from the previous call.
+ * @param eventCode Event code of the call.
+ * @param severity Severity of the call.
+ * @return pdPASS, or pdFAIL when the trace is exhausted (replay stops, or
+ *         restarts if TRACE_REPLAY_LOOP is set).
+ */
+BaseType_t TraceReplay_NextFromISR(uint32_t *delayUs, uint8_t *eventCode, uint8_t *severity);
+
+/**
+ * @brief Appends a generated call to the recording (ISR context).
+ *
+ * A call that does not fit in the buffer together with the gap records its
+ * delay needs is dropped whole and counted; the dump reports the count.
+ *
+ * @param nowUs Generator time of the call (microseconds, wrapping).
+ * @param eventCode Event code of the call.
+ * @param severity Severity of the call.
+ */
+void TraceRecorder_RecordFromISR(uint32_t nowUs, uint8_t eventCode, uint8_t severity);
+
+/**
+ * @brief Stops recording and logs the captured image as hex words (task context).
+ *
+ * Recording resumes, from an empty buffer, once the dump is complete. The
+ * first call recorded after that starts the new trace with a delay of 0.
+ */
+void TraceRecorder_Dump(void);
+
+/**
+ * @brief Schedules TraceRecorder_Dump() on the timer service task (ISR-safe).
+ *
+ * @param pxHigherPriorityTaskWoken Set to pdTRUE if a context switch is required.
+ */
+void TraceRecorder_RequestDumpFromISR(BaseType_t *pxHigherPriorityTaskWoken);
+
+#endif /* INC_TRACE_H_ */
@@ -0,0 +1,146 @@
+/**
+ * @file unit_lifecycle.h
+ * @brief Header file for the unit lifecycle (mission phases and shared unit state).
+ *
+ * A unit assigned to a call goes through
+ *
+ *   DISPATCHED -> EN_ROUTE -> ON_SCENE [-> TRANSPORTING] -> RETURNING -> AVAILABLE
+ *
+ * Every phase length is drawn from the department's distribution when the
+ * call is assigned, so the moment the unit will clear the call is known from
+ * the start. The call is complete when the unit leaves the scene (or the
+ * hospital); a RETURNING unit already counts as available and can be re-tasked
+ * on its way back.
+ *
+ * Each unit publishes its phase and its clear time in one 32-bit state word.
+ * Word stores are atomic, so the dispatcher can scan a department's state
+ * array at any time without locks.
+ *
+ * @date October 15, 2026
+ * @author shayb
+ */
+
+#ifndef INC_UNIT_LIFECYCLE_H_
+#define INC_UNIT_LIFECYCLE_H_
+
+#include "FreeRTOS.h"
+#include "project_config.h"
+#include <stdint.h>
+
+/**
+ * @brief Lifecycle phase of a unit.
+ */
+typedef enum
+{
+    UNIT_PHASE_AVAILABLE = 0, // At the station, waiting for a call
+    UNIT_PHASE_DISPATCHED,    // Call assigned, crew turning out
+    UNIT_PHASE_EN_ROUTE,      // Driving to the incident
+    UNIT_PHASE_ON_SCENE,      // Working the incident
+    UNIT_PHASE_TRANSPORTING,  // Taking a patient or suspect away (not every call)
+    UNIT_PHASE_RETURNING,     // Call cleared, driving back (can be re-tasked)
+    UNIT_PHASE_COUNT
+} UnitPhase_t;
+
+/**
+ * @brief Phase lengths of one mission, drawn at assignment.
+ */
+typedef struct
+{
+    uint16_t phaseTicks[UNIT_PHASE_COUNT]; /**< Wall-clock RTOS ticks per phase (0 = phase skipped). */
+} UnitMission_t;
+
+#define UNIT_STATE_PHASE_SHIFT 28
+#define UNIT_STATE_TICK_MASK ((1UL << UNIT_STATE_PHASE_SHIFT) - 1UL) // Clear time, modulo 2^28 ticks
+
+/**
+ * @brief Draws the phase lengths of a new mission (task context).
+ *
+ * The on-scene work of an incident is drawn once, on its first assignment, and
+ * kept in the event. A call that comes back after a pre-emption only gets the
+ * on-scene time it still needs; the other phases are drawn again.
+ *
+ * @param department Department of the unit (DepartmentId_t).
+ * @param event Call being assigned (sceneUs is set on the first assignment).
+ * @param mission Destination.
+ * @return Simulated ticks from assignment until the call is cleared.
+ */
+uint32_t UnitLifecycle_PlanMission(uint8_t department, EmergencyEvent_t *event, UnitMission_t *mission);
+
+/**
+ * @brief Wall-clock ticks from assignment until the call is cleared.
+ */
+TickType_t UnitLifecycle_BusyTicks(const UnitMission_t *mission);
+
+/**
+ * @brief Phase that follows @p phase in a mission (skips zero-length phases).
+ *
+ * @return The next phase; UNIT_PHASE_RETURNING once the call is cleared and
+ *         UNIT_PHASE_AVAILABLE after RETURNING.
+ */
+UnitPhase_t UnitLifecycle_NextPhase(const UnitMission_t *mission, UnitPhase_t phase);
+
+/**
+ * @brief Returns the printable name of a phase.
+ */
+const char *UnitLifecycle_PhaseName(uint8_t phase);
+
+/**
+ * @brief True while a unit is committed to a call (DISPATCHED .. TRANSPORTING).
+ */
+static inline BaseType_t UnitLifecycle_IsBusy(UnitPhase_t phase)
+{
+    return (phase >= UNIT_PHASE_DISPATCHED && phase <= UNIT_PHASE_TRANSPORTING) ? pdTRUE : pdFALSE;
+}
+
+/**
+ * @brief True while a unit may still be pre-empted (DISPATCHED .. ON_SCENE).
+ *
+ * A transporting unit keeps its patient or suspect until the hand-over.
+ */
+static inline BaseType_t UnitLifecycle_IsPreemptible(UnitPhase_t phase)
+{
+    return (phase >= UNIT_PHASE_DISPATCHED && phase <= UNIT_PHASE_ON_SCENE) ? pdTRUE : pdFALSE;
+}
+
+/**
+ * @brief Packs a phase and the tick at which the unit clears its call into a state word.
+ */
+static inline uint32_t UnitState_Pack(UnitPhase_t phase, TickType_t clearTick)
+{
+    return ((uint32_t)phase << UNIT_STATE_PHASE_SHIFT) | ((uint32_t)clearTick & UNIT_STATE_TICK_MASK);
+}
+
+/**
+ * @brief Phase stored in a state word.
+ */
+static inline UnitPhase_t UnitState_Phase(uint32_t state)
+{
+    return (UnitPhase_t)(state >> UNIT_STATE_PHASE_SHIFT);
+}
+
+/**
+ * @brief Clear tick stored in a state word (low 28 bits of the RTOS tick).
+ */
+static inline TickType_t UnitState_ClearTick(uint32_t state)
+{
+    return (TickType_t)(state & UNIT_STATE_TICK_MASK);
+}
+
+/**
+ * @brief Wall-clock ticks until a unit clears its call (0 if it is not busy or overdue).
+ *
+ * @param state State word.
+ * @param now Current RTOS tick.
+ */
+static inline TickType_t UnitState_TicksUntilClear(uint32_t state, TickType_t now)
+{
+    uint32_t remaining = (UnitState_ClearTick(state) - (uint32_t)now) & UNIT_STATE_TICK_MASK;
+
+    if (!UnitLifecycle_IsBusy(UnitState_Phase(state)) || remaining > (UNIT_STATE_TICK_MASK >> 1))
+    {
+        return 0;
+    }
+    return (TickType_t)remaining;
+}
+
+#endif /* INC_UNIT_LIFECYCLE_H_ */
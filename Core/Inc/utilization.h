@@ -0,0 +1,115 @@
+/**
+ * @file utilization.h
+ * @brief Header file for unit and department utilization accounting.
+ *
+ * Every unit carries a UnitUtil_t that records how long it has spent in each
+ * lifecycle phase (unit_lifecycle.h). The clock is the simulated time base,
+ * which is derived from the DWT cycle counter, so the accounting resolution is
+ * one microsecond rather than one RTOS tick. Each phase change costs O(1): the
+ * time since the previous change is credited to the phase being left, and the
+ * department's aggregate is moved forward by the same amount.
+ *
+ * The department aggregate keeps
+ *   - the number of units in each phase,
+ *   - the lifetime unit-time spent in each phase,
+ *   - a rolling busy share over UTILIZATION_WINDOW_COUNT windows of
+ *     UTILIZATION_WINDOW_MS.
+ *
+ * A unit counts as busy while it is committed to a call (DISPATCHED ..
+ * TRANSPORTING). RETURNING is reported separately: the unit is away from the
+ * station but can already be re-tasked.
+ *
+ * Queries take a short critical section and can be made at any time while the
+ * system runs.
+ *
+ * @date October 15, 2026
+ * @author shayb
+ */
+
+#ifndef INC_UTILIZATION_H_
+#define INC_UTILIZATION_H_
+
+#include "FreeRTOS.h"
+#include "project_config.h"
+#include "unit_lifecycle.h"
+#include <stdint.h>
+
+/**
+ * @brief Time accounting of one unit. Storage is supplied by the owner.
+ *
+ * Phase times are whole milliseconds plus a microsecond remainder, which keeps
+ * them exact without a 64-bit counter per phase.
+ */
+typedef struct
+{
+    TimeStamp_t sinceUs;                      /**< Simulated time of the last phase change. */
+    uint32_t phaseMs[UNIT_PHASE_COUNT];       /**< Completed time in each phase, ms. */
+    uint16_t phaseRemUs[UNIT_PHASE_COUNT];    /**< Sub-millisecond remainder of phaseMs. */
+    uint8_t phase;                            /**< Current UnitPhase_t. */
+    uint8_t department;                       /**< DepartmentId_t. */
+} UnitUtil_t;
+
+/**
+ * @brief Snapshot of one unit's accounting, current phase included.
+ */
+typedef struct
+{
+    uint32_t phaseMs[UNIT_PHASE_COUNT]; /**< Time in each phase since the unit started, ms. */
+    uint32_t busyMs;                    /**< DISPATCHED .. TRANSPORTING. */
+    uint32_t totalMs;                   /**< Time since the unit started. */
+    uint16_t busyPermille;              /**< busyMs / totalMs. */
+    uint8_t phase;                      /**< Current UnitPhase_t. */
+} UnitUtilization_t;
+
+/**
+ * @brief Snapshot of one department's accounting.
+ */
+typedef struct
+{
+    uint16_t numUnits;                          /**< Units registered. */
+    uint16_t unitsInPhase[UNIT_PHASE_COUNT];    /**< Units currently in each phase. */
+    uint16_t busyUnits;                         /**< Units currently committed to a call. */
+    uint16_t rollingBusyPermille;               /**< Busy share over the rolling window. */
+    uint32_t rollingSpanMs;                     /**< Time the rolling share covers (shorter right after boot). */
+    uint16_t phasePermille[UNIT_PHASE_COUNT];   /**< Lifetime share of unit-time in each phase. */
+} DeptUtilization_t;
+
+/**
+ * @brief Registers a unit with its department, in phase AVAILABLE (task context).
+ *
+ * @param unit Accounting record of the unit.
+ * @param department Department of the unit (DepartmentId_t).
+ */
+void Utilization_InitUnit(UnitUtil_t *unit, uint8_t department);
+
+/**
+ * @brief Records a phase change of a unit, O(1), task context.
+ *
+ * @param unit Accounting record of the unit.
+ * @param phase Phase the unit enters (no-op if it is already in it).
+ */
+void Utilization_Transition(UnitUtil_t *unit, UnitPhase_t phase);
+
+/**
+ * @brief Reads one unit's accounting, time spent in the current phase included.
+ */
+void Utilization_GetUnit(const UnitUtil_t *unit, UnitUtilization_t *out);
+
+/**
+ * @brief Reads one department's accounting, brought up to date to now.
+ *
+ * @param department Department to read (DepartmentId_t).
+ * @param out Destination.
+ */
+void Utilization_GetDept(uint8_t department, DeptUtilization_t *out);
+
+/**
+ * @brief Logs the utilization of every department.
+ *
+ * A department whose rolling busy share reaches UTILIZATION_SATURATION_PCT is
+ * reported as a warning: it is running out of units even if its queue has not
+ * overflowed yet.
+ */
+void Utilization_Dump(void);
+
+#endif /* INC_UTILIZATION_H_ */
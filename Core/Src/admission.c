@@ -0,0 +1,135 @@
+/**
+ * @file admission.c
+ * @brief Implementation of the admission controller.
+ *
+ * The saturation level is a single byte written by the dispatcher and read by
+ * the generator ISR, so publishing and reading need no locking. The counters
+ * are written by the ingress path only and copied out under a critical section.
+ *
+ * @date October 15, 2026
+ * @author shayb
+ */
+
+#include "admission.h"
+#include "task.h"
+
+static volatile uint8_t saturationLevel = SATURATION_NORMAL;
+static AdmissionStats_t admissionStats = {0};
+
+/**
+ * @brief Admission policy, indexed by [saturation level][severity].
+ *
+ * High and critical calls are always admitted; pressure is taken off the
+ * system by the low and medium ones first.
+ */
+static const uint8_t admissionPolicy[SATURATION_LEVEL_COUNT][NUM_SEVERITY_LEVELS] = {
+    [SATURATION_NORMAL] = {ADMIT_ACCEPT, ADMIT_ACCEPT, ADMIT_ACCEPT, ADMIT_ACCEPT},
+    [SATURATION_ELEVATED] = {ADMIT_DEFER, ADMIT_ACCEPT, ADMIT_ACCEPT, ADMIT_ACCEPT},
+    [SATURATION_SATURATED] = {ADMIT_SHED, ADMIT_DEFER, ADMIT_ACCEPT, ADMIT_ACCEPT},
+    [SATURATION_OVERLOADED] = {ADMIT_SHED, ADMIT_DOWNGRADE, ADMIT_ACCEPT, ADMIT_ACCEPT},
+};
+
+static const char *const levelNames[SATURATION_LEVEL_COUNT] = {
+    [SATURATION_NORMAL] = "normal",
+    [SATURATION_ELEVATED] = "elevated",
+    [SATURATION_SATURATED] = "saturated",
+    [SATURATION_OVERLOADED] = "overloaded",
+};
+
+// --- Public Functions ---
+
+void Admission_Publish(UBaseType_t total, UBaseType_t capacity, UBaseType_t idleUnits)
+{
+    UBaseType_t fillPct = (capacity > 0) ? (total * 100U) / capacity : 100U;
+    uint8_t level;
+
+    if (idleUnits > 0 || fillPct < ADMISSION_ELEVATED_PCT)
+    {
+        level = SATURATION_NORMAL; // Spare capacity: anything posted now is served soon
+    }
+    else if (fillPct < ADMISSION_SATURATED_PCT)
+    {
+        level = SATURATION_ELEVATED;
+    }
+    else if (fillPct < ADMISSION_OVERLOADED_PCT)
+    {
+        level = SATURATION_SATURATED;
+    }
+    else
+    {
+        level = SATURATION_OVERLOADED;
+    }
+
+    saturationLevel = level;
+}
+
+SaturationLevel_t Admission_GetLevel(void)
+{
+    return (SaturationLevel_t)saturationLevel;
+}
+
+AdmissionAction_t Admission_Decide(uint8_t severity)
+{
+    if (severity >= NUM_SEVERITY_LEVELS)
+    {
+        return ADMIT_ACCEPT;
+    }
+    return (AdmissionAction_t)admissionPolicy[saturationLevel][severity];
+}
+
+void Admission_CountAdmit(AdmissionAction_t action, uint8_t wasDeferred)
+{
+    switch (action)
+    {
+    case ADMIT_DEFER:
+        admissionStats.deferred++;
+        return; // Not posted yet
+    case ADMIT_DOWNGRADE:
+        admissionStats.downgraded++;
+        break;
+    case ADMIT_ACCEPT:
+    default:
+        break;
+    }
+
+    admissionStats.admitted++;
+    if (wasDeferred)
+    {
+        admissionStats.deferAdmitted++;
+    }
+}
+
+void Admission_CountShed(ShedReason_t reason)
+{
+    switch (reason)
+    {
+    case SHED_SATURATION:
+        admissionStats.shedSaturation++;
+        break;
+    case SHED_DEFER_TIMEOUT:
+        admissionStats.shedDeferTimeout++;
+        break;
+    case SHED_DEFER_FULL:
+        admissionStats.shedDeferFull++;
+        break;
+    case SHED_QUEUE_FULL:
+        admissionStats.shedQueueFull++;
+        break;
+    case SHED_POOL_EMPTY:
+    default:
+        admissionStats.shedPoolEmpty++;
+        break;
+    }
+}
+
+void Admission_GetStats(AdmissionStats_t *stats)
+{
+    taskENTER_CRITICAL(); // Masks the generator ISR (priority 5) while copying
+    *stats = admissionStats;
+    taskEXIT_CRITICAL();
+}
+
+const char *Admission_LevelName(SaturationLevel_t level)
+{
+    return (level < SATURATION_LEVEL_COUNT) ? levelNames[level] : "unknown";
+}
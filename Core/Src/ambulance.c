@@ -16,13 +16,15 @@
 #include "FreeRTOS.h"
 #include "task.h"
 #include "queue.h"
+#include "prio_queue.h"
 #include <stdio.h>
 
 /**
  * @brief Queue handle for the Ambulance Department.
  */
-QueueHandle_t xAmbulanceQueue = NULL;
+PrioQueueHandle_t xAmbulanceQueue = NULL;
 
+#if UNIT_MODEL == UNIT_MODEL_TASK
 /**
  * @brief Task parameter storage for ambulance tasks.
  *
@@ -37,6 +39,7 @@ static ResourceTaskParams_t ambulanceTaskParams[RESOURCES_AMBULANCE];
  * This array stores the unique names for each ambulance task instance.
  */
 static char ambulanceTaskNames[RESOURCES_AMBULANCE][configMAX_TASK_NAME_LEN];
+#endif
 
 /**
  * @brief Initializes the Ambulance Department.
@@ -47,10 +50,12 @@ static char ambulanceTaskNames[RESOURCES_AMBULANCE][configMAX_TASK_NAME_LEN];
  * @param numUnits The number of ambulance units to initialize.
  * @return pdPASS if all tasks are created successfully, pdFAIL otherwise.
  */
-BaseType_t Ambulance_Init(uint8_t numUnits)
+BaseType_t Ambulance_Init(uint16_t numUnits)
 {
     BaseType_t xReturned = pdPASS;
+#if UNIT_MODEL == UNIT_MODEL_TASK
     uint8_t i;
+#endif
 
     printf("Initializing Ambulance Department with %d units...\r\n", numUnits);
 
@@ -67,10 +72,20 @@ BaseType_t Ambulance_Init(uint8_t numUnits)
         return pdFAIL; // Cannot proceed
     }
 
+#if UNIT_MODEL == UNIT_MODEL_SCHEDULER
+    // One scheduler task simulates every unit of the department
+    if (ResourceUnit_CreateScheduler(DEPT_AMBULANCE, xAmbulanceQueue, numUnits, "Ambulance") != pdPASS)
+    {
+        printf("Failed to create Ambulance scheduler!\r\n");
+        return pdFAIL;
+    }
+#else
     for (i = 0; i < numUnits; ++i)
     {
         // Prepare parameters for this specific task instance
         ambulanceTaskParams[i].xDepartmentQueue = xAmbulanceQueue;
+        ambulanceTaskParams[i].departmentType = DEPT_AMBULANCE;
+        ambulanceTaskParams[i].unitIndex = i;
 
         // Create a unique name for this task instance
         snprintf(ambulanceTaskNames[i], configMAX_TASK_NAME_LEN, "Ambulance_%d", i + 1);
@@ -90,6 +105,7 @@ BaseType_t Ambulance_Init(uint8_t numUnits)
             return pdFAIL; // Stop initialization on first failure
         }
     }
+#endif
 
     printf("Ambulance task creation complete.\r\n");
     return xReturned; // pdPASS if all tasks created ok (or pdFAIL if clamped/error)
@@ -0,0 +1,173 @@
+/**
+ * @file arrival_model.c
+ * @brief Implementation of the event arrival-process models.
+ *
+ * Exponential delays come from an inverse-CDF table of -ln(1 - u) in Q16.16,
+ * indexed by the top bits of the random word and linearly interpolated with the
+ * next bits. Each model only scales that unit exponential by a mean taken from
+ * its own small table: one entry (Poisson, stress), two (MMPP calm/burst) or one
+ * per hour (diurnal).
+ *
+ * @date October 15, 2026
+ * @author shayb
+ */
+
+#include "arrival_model.h"
+#include <math.h>
+
+#define EXP_TABLE_BITS 8
+#define EXP_TABLE_SIZE (1U << EXP_TABLE_BITS)
+#define EXP_INTERP_BITS 8 // Random bits used to interpolate between table points
+#define DIURNAL_SLOTS 24
+
+#if (EXP_TABLE_BITS + EXP_INTERP_BITS) > 24
+#error "Exponential table index and interpolation bits overlap the MMPP bits"
+#endif
+
+/**
+ * @brief Relative call rate per hour of day, in percent of the daily mean.
+ */
+static const uint8_t diurnalRatePct[DIURNAL_SLOTS] = {
+    40, 30, 25, 20, 20, 30, 55, 85, 110, 120, 125, 130,  // 00:00 - 11:00
+    135, 130, 125, 125, 130, 140, 150, 150, 140, 120, 90, 60 // 12:00 - 23:00
+};
+
+static const char *const modelNames[ARRIVAL_MODEL_COUNT] = {
+    [ARRIVAL_UNIFORM] = "uniform",
+    [ARRIVAL_POISSON] = "poisson",
+    [ARRIVAL_MMPP] = "mmpp",
+    [ARRIVAL_DIURNAL] = "diurnal",
+    [ARRIVAL_STRESS] = "stress",
+};
+
+// --- Lookup Tables (built by ArrivalModel_Init) ---
+static uint32_t expQuantileQ16[EXP_TABLE_SIZE + 1]; // -ln(1 - u) at u = i / SIZE, Q16.16
+static uint32_t diurnalMeanUs[DIURNAL_SLOTS];        // Mean delay for each hour slot
+
+// --- Model State (ISR only after init) ---
+static volatile uint8_t activeModel = ARRIVAL_MODEL;
+static uint8_t mmppBurst = 0;       // 1 while the MMPP is in its burst state
+static uint8_t diurnalSlot = 0;     // Current hour of the simulated day
+static uint32_t diurnalSlotUs = 0;  // Time spent in the current hour
+
+// --- Private Functions ---
+
+/**
+ * @brief Draws a unit-mean exponential variate, Q16.16.
+ */
+static inline uint32_t ArrivalModel_UnitExpQ16(uint32_t randomValue)
+{
+    uint32_t index = randomValue >> (32U - EXP_TABLE_BITS);
+    uint32_t frac = (randomValue >> (32U - EXP_TABLE_BITS - EXP_INTERP_BITS)) & ((1U << EXP_INTERP_BITS) - 1U);
+    uint32_t lo = expQuantileQ16[index];
+    uint32_t hi = expQuantileQ16[index + 1U];
+
+    return lo + (((hi - lo) * frac) >> EXP_INTERP_BITS);
+}
+
+/**
+ * @brief Scales a unit exponential to the given mean.
+ */
+static inline uint32_t ArrivalModel_ScaleUs(uint32_t meanUs, uint32_t unitQ16)
+{
+    uint64_t us = ((uint64_t)meanUs * unitQ16) >> 16;
+
+    if (us == 0)
+    {
+        return 1;
+    }
+    return (us > UINT32_MAX) ? UINT32_MAX : (uint32_t)us;
+}
+
+// --- Public Functions ---
+
+void ArrivalModel_Init(void)
+{
+    uint32_t i;
+
+    // Inverse CDF of the unit exponential. The last point would be infinite; it
+    // is placed at the quantile of the middle of the last interval instead.
+    for (i = 0; i < EXP_TABLE_SIZE; ++i)
+    {
+        expQuantileQ16[i] = (uint32_t)(-logf(1.0f - (float)i / EXP_TABLE_SIZE) * 65536.0f);
+    }
+    expQuantileQ16[EXP_TABLE_SIZE] = (uint32_t)(-logf(0.5f / EXP_TABLE_SIZE) * 65536.0f);
+
+    // Hour slots: a higher rate means a proportionally shorter mean delay
+    for (i = 0; i < DIURNAL_SLOTS; ++i)
+    {
+        diurnalMeanUs[i] = (uint32_t)(((uint64_t)ARRIVAL_DIURNAL_MEAN_US * 100U) / diurnalRatePct[i]);
+    }
+
+    mmppBurst = 0;
+    diurnalSlot = 0;
+    diurnalSlotUs = 0;
+    activeModel = ARRIVAL_MODEL;
+}
+
+BaseType_t ArrivalModel_Select(ArrivalModel_t model)
+{
+    if (model >= ARRIVAL_MODEL_COUNT)
+    {
+        return pdFAIL;
+    }
+    activeModel = (uint8_t)model; // Single byte write, read once per draw by the ISR
+    return pdPASS;
+}
+
+ArrivalModel_t ArrivalModel_GetActive(void)
+{
+    return (ArrivalModel_t)activeModel;
+}
+
+uint32_t ArrivalModel_NextDelayUsFromISR(uint32_t randomValue)
+{
+    uint32_t delayUs;
+
+    switch (activeModel)
+    {
+    case ARRIVAL_POISSON:
+        return ArrivalModel_ScaleUs(ARRIVAL_POISSON_MEAN_US, ArrivalModel_UnitExpQ16(randomValue));
+
+    case ARRIVAL_MMPP:
+        // The low byte decides the state switch, the high bits draw the delay
+        if (mmppBurst)
+        {
+            mmppBurst = ((randomValue & 0xFFU) >= ARRIVAL_MMPP_LEAVE_BURST_P256);
+        }
+        else
+        {
+            mmppBurst = ((randomValue & 0xFFU) < ARRIVAL_MMPP_ENTER_BURST_P256);
+        }
+        return ArrivalModel_ScaleUs(mmppBurst ? ARRIVAL_MMPP_BURST_MEAN_US : ARRIVAL_MMPP_CALM_MEAN_US,
+                                    ArrivalModel_UnitExpQ16(randomValue));
+
+    case ARRIVAL_DIURNAL:
+        delayUs = ArrivalModel_ScaleUs(diurnalMeanUs[diurnalSlot], ArrivalModel_UnitExpQ16(randomValue));
+        // Advance the simulated clock (rarely more than one slot per draw)
+        diurnalSlotUs += delayUs;
+        while (diurnalSlotUs >= ARRIVAL_DIURNAL_HOUR_US)
+        {
+            diurnalSlotUs -= ARRIVAL_DIURNAL_HOUR_US;
+            diurnalSlot = (diurnalSlot + 1U) % DIURNAL_SLOTS;
+        }
+        return delayUs;
+
+    case ARRIVAL_STRESS:
+        return ArrivalModel_ScaleUs(ARRIVAL_STRESS_MEAN_US, ArrivalModel_UnitExpQ16(randomValue));
+
+    case ARRIVAL_UNIFORM:
+    default:
+        return (randomValue % DELAY_RANGE_US) + MIN_EVENT_DELAY_US;
+    }
+}
+
+uint32_t ArrivalModel_ExpDelayUsFromISR(uint32_t meanUs, uint32_t randomValue)
+{
+    return ArrivalModel_ScaleUs(meanUs, ArrivalModel_UnitExpQ16(randomValue));
+}
+
+const char *ArrivalModel_Name(ArrivalModel_t model)
+{
+    return (model < ARRIVAL_MODEL_COUNT) ? modelNames[model] : "unknown";
+}
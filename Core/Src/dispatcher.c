@@ -14,6 +14,16 @@
 #include "FreeRTOS.h"
 #include "queue.h"
 #include "task.h"
+#include "timers.h" // For xTimerPendFunctionCall (deferred mode)
+#include "prio_queue.h"
+#include "spsc_ring.h"
+#include "routing_table.h"
+#include "event_pool.h"
+#include "resource_task.h"
+#include "admission.h"
+#include "time_base.h"
+#include "utilization.h"
+#include "district.h" // For District_Name
 #include "semphr.h" // For mutex creation
 #include "logging.h"
 
@@ -22,15 +32,88 @@
 #include "police.h"
 #include "fire_dept.h"
 
-QueueHandle_t xDispatcherQueue = NULL;
+#if NUM_SEVERITY_LEVELS > PRIO_QUEUE_MAX_LEVELS
+#error "NUM_SEVERITY_LEVELS exceeds PRIO_QUEUE_MAX_LEVELS"
+#endif
 
-extern QueueHandle_t xPoliceQueue;    // Queue for Police department task
-extern QueueHandle_t xAmbulanceQueue; // Queue for Ambulance department task
-extern QueueHandle_t xFireDeptQueue;  // Queue for Fire Dept department task
+#if (DISPATCHER_RING_LENGTH & (DISPATCHER_RING_LENGTH - 1)) != 0
+#error "DISPATCHER_RING_LENGTH must be a power of two"
+#endif
+
+/**
+ * @def DISPATCHER_BACKLOG_CAPACITY
+ * @brief Events the departments can hold before calls are shed: queue slots,
+ *        parked slots and one per unit.
+ *
+ * The input rings are left out: the dispatcher empties them on every wake-up,
+ * so a backlog builds up behind it, not in front of it.
+ */
+#define DISPATCHER_BACKLOG_CAPACITY                                                  \
+    ((POLICE_DEPT_QUEUE_LENGTH + AMBULANCE_DEPT_QUEUE_LENGTH + FIRE_DEPT_QUEUE_LENGTH) + \
+     (DEPT_COUNT * OVERFLOW_RING_LENGTH) +                                               \
+     (RESOURCES_POLICE + RESOURCES_AMBULANCE + RESOURCES_FIRE_DEPT))
+
+#if DISPATCHER_MODE == DISPATCHER_MODE_DEFERRED
+_Static_assert(configTIMER_TASK_PRIORITY >= TASK_PRIO_DISPATCHER, "The deferred dispatcher must not run below TASK_PRIO_DISPATCHER");
+#endif
+
+extern PrioQueueHandle_t xPoliceQueue;    // Queue for Police department task
+extern PrioQueueHandle_t xAmbulanceQueue; // Queue for Ambulance department task
+extern PrioQueueHandle_t xFireDeptQueue;  // Queue for Fire Dept department task
 extern SemaphoreHandle_t xUartMutex;
 
+/**
+ * @brief Department queues indexed by DepartmentId_t (handles are created at runtime).
+ */
+static PrioQueueHandle_t *const deptQueues[DEPT_COUNT] = {
+    [DEPT_POLICE] = &xPoliceQueue,
+    [DEPT_AMBULANCE] = &xAmbulanceQueue,
+    [DEPT_FIRE] = &xFireDeptQueue,
+};
+
 static void Dispatcher_Task(void *pvParameters);
 
+static TaskHandle_t xDispatcherTaskHandle = NULL;
+
+// --- Overflow Rings ---
+
+/**
+ * @brief Per-department ring of events parked while the department queue is full.
+ *
+ * Only the dispatcher context (Dispatcher_Task, or the timer service task in
+ * deferred mode) touches the rings; units just test parkedDeptMask.
+ */
+typedef struct
+{
+    EventHandle_t items[OVERFLOW_RING_LENGTH];
+    uint8_t head;  // Oldest parked event
+    uint8_t count; // Number of parked events
+} OverflowRing_t;
+
+static OverflowRing_t overflowRings[DEPT_COUNT];
+static volatile uint32_t parkedDeptMask = 0; // Bit N set while department N has parked events
+
+// --- Input Rings (TIM2 ISR -> dispatcher context) ---
+static EventHandle_t inputStorage[NUM_SEVERITY_LEVELS][DISPATCHER_RING_LENGTH];
+static SpscRing_t inputRings[NUM_SEVERITY_LEVELS]; // One per severity, drained most severe first; lock-free
+
+#if DISPATCHER_MODE == DISPATCHER_MODE_DEFERRED
+static uint8_t deferredPendFailed = 0; // Timer command queue was full; the next post pends again
+
+static void Dispatcher_DeferredWork(void *pvParameter1, uint32_t ulParameter2);
+static void Dispatcher_DeferredReoffer(void *pvParameter1, uint32_t ulParameter2);
+#endif
+
+static void Dispatcher_UpdateSaturation(void);
+
+#if PREEMPTION_MODE == PREEMPTION_AB
+static void Dispatcher_PreemptionAbSwitch(TimerHandle_t xTimer);
+#endif
+
+// --- Statistics ---
+static DispatcherStats_t dispatcherStats = {0}; // Updated by the dispatcher context only
+extern volatile uint32_t ulContextSwitchCount;  // Maintained by traceTASK_SWITCHED_IN (freertos.c)
+
 /**
  * @brief Error handler for initialization failures.
  *
@@ -50,29 +133,36 @@ static void ErrorHandler(const char *context)
 
 void CreateQueuesAndSemaphores(void)
 {
+    uint8_t severity;
+
     printf("Creating Queues and Semaphores...\r\n"); // Logging might not work reliably yet
 
-    // Create Dispatcher Queue
-    xDispatcherQueue = xQueueCreate(DISPATCHER_QUEUE_LENGTH, DISPATCHER_QUEUE_ITEM_SIZE);
-    if (xDispatcherQueue == NULL)
+    // Event records are pooled; the queues below only carry their handles
+    EventPool_Init();
+
+    // Dispatcher input: one lock-free ring per severity, fed by the TIM2 ISR
+    for (severity = 0; severity < NUM_SEVERITY_LEVELS; ++severity)
     {
-        ErrorHandler("DispatcherQ");
+        if (SpscRing_Init(&inputRings[severity], inputStorage[severity], DISPATCHER_RING_LENGTH) != pdPASS)
+        {
+            ErrorHandler("DispatcherRing");
+        }
     }
 
-    // Create Shared Department Queues
-    xAmbulanceQueue = xQueueCreate(AMBULANCE_DEPT_QUEUE_LENGTH, DISPATCHER_QUEUE_ITEM_SIZE);
+    // Create Shared Department Queues (also severity-ordered)
+    xAmbulanceQueue = PrioQueue_Create(AMBULANCE_DEPT_QUEUE_LENGTH, DISPATCHER_QUEUE_ITEM_SIZE);
     if (xAmbulanceQueue == NULL)
     {
         ErrorHandler("AmbulanceQ");
     }
 
-    xPoliceQueue = xQueueCreate(POLICE_DEPT_QUEUE_LENGTH, DISPATCHER_QUEUE_ITEM_SIZE);
+    xPoliceQueue = PrioQueue_Create(POLICE_DEPT_QUEUE_LENGTH, DISPATCHER_QUEUE_ITEM_SIZE);
     if (xPoliceQueue == NULL)
     {
         ErrorHandler("PoliceQ");
     }
 
-    xFireDeptQueue = xQueueCreate(FIRE_DEPT_QUEUE_LENGTH, DISPATCHER_QUEUE_ITEM_SIZE);
+    xFireDeptQueue = PrioQueue_Create(FIRE_DEPT_QUEUE_LENGTH, DISPATCHER_QUEUE_ITEM_SIZE);
     if (xFireDeptQueue == NULL)
     {
         ErrorHandler("FireDeptQ");
@@ -175,9 +265,28 @@ void InitializeModules(void)
 BaseType_t Dispatcher_Init(void)
 {
     BaseType_t xReturned;
+#if PREEMPTION_MODE == PREEMPTION_AB
+    TimerHandle_t xAbTimer;
+#endif
 
     printf("Initializing Dispatcher...\r\n");
 
+#if PREEMPTION_MODE == PREEMPTION_AB
+    // Alternate pre-emption on a fixed period, however often the dispatcher wakes
+    xAbTimer = xTimerCreate("PreemptAB", pdMS_TO_TICKS(PREEMPTION_AB_PERIOD_MS), pdTRUE, NULL, Dispatcher_PreemptionAbSwitch);
+    if (xAbTimer == NULL || xTimerStart(xAbTimer, 0) != pdPASS)
+    {
+        printf("Failed to start the pre-emption A/B timer\r\n");
+        return pdFAIL;
+    }
+#endif
+
+#if DISPATCHER_MODE == DISPATCHER_MODE_DEFERRED
+    // Routing runs in the timer service task; no dispatcher task is needed
+    printf("Dispatcher running deferred on the timer service task.\r\n");
+    return pdPASS;
+#endif
+
     // Create the Dispatcher Task
     xReturned = xTaskCreate(
         Dispatcher_Task,            // Function that implements the task.
@@ -185,7 +294,7 @@ BaseType_t Dispatcher_Init(void)
         TASK_STACK_SIZE_DISPATCHER, // Stack size from project_config.h
         NULL,                       // Parameter passed into the task (not used).
         TASK_PRIO_DISPATCHER,       // Priority from project_config.h
-        NULL);                      // Used to pass out the created task's handle (optional).
+        &xDispatcherTaskHandle);    // Needed for input and drain notifications.
 
     if (xReturned != pdPASS)
     {
@@ -198,125 +307,482 @@ BaseType_t Dispatcher_Init(void)
     return xReturned;
 }
 
-static void Dispatcher_Task(void *pvParameters)
+BaseType_t Dispatcher_PostFromISR(EventHandle_t handle, uint8_t severity, BaseType_t *pxHigherPriorityTaskWoken)
 {
-    EmergencyEvent_t receivedEvent; // Structure to hold the received event
-    BaseType_t xStatus;
-    const TickType_t xSendTicksToWait = pdMS_TO_TICKS(10); // Small timeout for sending
-    UBaseType_t primaryQueueMsgs;
-    UBaseType_t alternativeQueueMsgs;
+    BaseType_t xWasEmpty;
 
-    LogInfo("Dispatcher Task running.\r\n");
+    configASSERT(severity < NUM_SEVERITY_LEVELS);
+    if (SpscRing_Push(&inputRings[severity], handle, &xWasEmpty) != pdPASS)
+    {
+        return errQUEUE_FULL;
+    }
 
-    while (1)
+    // Coalesced wake-up: while a ring is non-empty the consumer is already due
+    // to run and drains everything posted since, so only a post to a drained
+    // ring needs a kernel call (the consumer checks every ring before sleeping).
+#if DISPATCHER_MODE == DISPATCHER_MODE_DEFERRED
+    if (xWasEmpty || deferredPendFailed)
+    {
+        deferredPendFailed = (xTimerPendFunctionCallFromISR(Dispatcher_DeferredWork, NULL, 0, pxHigherPriorityTaskWoken) != pdPASS);
+    }
+#else
+    if (xWasEmpty && xDispatcherTaskHandle != NULL)
+    {
+        xTaskNotifyFromISR(xDispatcherTaskHandle, DISPATCHER_NOTIFY_INPUT, eSetBits, pxHigherPriorityTaskWoken);
+    }
+#endif
+    return pdPASS;
+}
+
+void Dispatcher_NotifyDrained(uint8_t department)
+{
+    // Under saturation the dispatcher also wakes to republish the easing pressure right away
+    if ((parkedDeptMask & (1UL << department)) == 0 && Admission_GetLevel() == SATURATION_NORMAL)
+    {
+        return;
+    }
+#if DISPATCHER_MODE == DISPATCHER_MODE_DEFERRED
+    (void)xTimerPendFunctionCall(Dispatcher_DeferredReoffer, NULL, 0, 0); // If full, the next drain retries
+#else
+    if (xDispatcherTaskHandle != NULL)
+    {
+        xTaskNotify(xDispatcherTaskHandle, DISPATCHER_NOTIFY_DRAIN, eSetBits);
+    }
+#endif
+}
+
+void Dispatcher_GetStats(DispatcherStats_t *stats)
+{
+    taskENTER_CRITICAL();
+    *stats = dispatcherStats;
+    stats->contextSwitches = ulContextSwitchCount;
+    taskEXIT_CRITICAL();
+}
+
+/**
+ * @brief Recomputes the system saturation level and publishes it to admission control.
+ *
+ * The load is every event in flight, read off the pool: queued, parked, in
+ * service, deferred or still in the input rings. It is measured against
+ * DISPATCHER_BACKLOG_CAPACITY, so the levels track how close the departments
+ * are to shedding calls.
+ */
+static void Dispatcher_UpdateSaturation(void)
+{
+    DeptUnitStatus_t unitStatus;
+    UBaseType_t idleUnits = 0;
+    uint8_t dept;
+
+    for (dept = 0; dept < DEPT_COUNT; ++dept)
+    {
+        ResourceUnit_GetStatus(dept, &unitStatus);
+        idleUnits += unitStatus.idleUnits;
+    }
+
+    Admission_Publish(EVENT_POOL_SIZE - EventPool_FreeCount(), DISPATCHER_BACKLOG_CAPACITY, idleUnits);
+}
+
+/**
+ * @brief Delivers an event to a department without blocking.
+ *
+ * Hands the event straight to an idle unit when there is one; otherwise it is
+ * queued. Events never overtake ones already parked for the same department.
+ *
+ * @param department Target department.
+ * @param handle Pool handle of the event.
+ * @param severity Severity of the event.
+ * @return pdPASS if the event was handed off or queued, errQUEUE_FULL otherwise.
+ */
+static BaseType_t Dispatcher_Deliver(uint8_t department, EventHandle_t handle, uint8_t severity)
+{
+    if (overflowRings[department].count > 0)
     {
-        // Wait indefinitely for an event to arrive from the event generator
-        xStatus = xQueueReceive(xDispatcherQueue, &receivedEvent, portMAX_DELAY);
+        return errQUEUE_FULL; // Keep FIFO order behind the parked events
+    }
 
-        if (xStatus == pdPASS)
+    switch (ResourceUnit_HandOff(department, *deptQueues[department], handle, severity))
+    {
+    case HANDOFF_TO_UNIT:
+        LogDebug("Event handed directly to an idle [%s] unit.\r\n", Routing_DeptName(department));
+        return pdPASS;
+    case HANDOFF_QUEUED:
+        return pdPASS;
+    case HANDOFF_PREEMPTED:
+        dispatcherStats.preemptions++;
+        LogDebug("Event queued, a [%s] unit on a less severe call was interrupted for it.\r\n", Routing_DeptName(department));
+        return pdPASS;
+    case HANDOFF_REJECTED:
+    default:
+        return errQUEUE_FULL;
+    }
+}
+
+/**
+ * @brief Re-offers parked events to their departments, oldest first.
+ *
+ * Stops per department at the first rejection; the next drain notification
+ * resumes from there.
+ */
+static void Dispatcher_ReofferParked(void)
+{
+    uint8_t dept;
+
+    for (dept = 0; dept < DEPT_COUNT; ++dept)
+    {
+        OverflowRing_t *ring = &overflowRings[dept];
+
+        while (ring->count > 0)
         {
-            // Successfully received an event
-            LogDebug("Dispatcher received event code %d\r\n", receivedEvent.eventCode);
-
-            // Determine primary target department and queue, and alternative if applicable
-            QueueHandle_t xPrimaryQueue = NULL;
-            QueueHandle_t xAlternativeQueue = NULL;
-            const char *primaryDeptName = "Unknown";
-            const char *alternativeDeptName = "None";
-            BaseType_t attemptRedirect = pdFALSE;
-
-            // --- Define Dispatching and Redirection Rules ---
-            switch (receivedEvent.eventCode)
-            {
-            case EVENT_CODE_POLICE:
-                xPrimaryQueue = xPoliceQueue;
-                primaryDeptName = "Police";
-                // No alternative defined for Police
-                break;
-            case EVENT_CODE_AMBULANCE:
-                xPrimaryQueue = xAmbulanceQueue;
-                primaryDeptName = "Ambulance";
-                // Define Police as alternative
-                xAlternativeQueue = xPoliceQueue;
-                alternativeDeptName = "Police";
-                attemptRedirect = pdTRUE; // Allow redirection for Ambulance calls
-                break;
-            case EVENT_CODE_FIRE_DEPT:
-                xPrimaryQueue = xFireDeptQueue;
-                primaryDeptName = "FireDept";
-                // No alternative defined for Fire Dept
-                break;
-            default:
-                LogWarn("Dispatcher received unknown event code: %d\r\n", receivedEvent.eventCode);
-                continue; // Skip processing this unknown event
-            }
-            // --- End of Rules ---
+            EventHandle_t handle = ring->items[ring->head];
 
-            // Ensure primary queue is valid before proceeding
-            if (xPrimaryQueue == NULL)
+            if (ResourceUnit_HandOff(dept, *deptQueues[dept], handle, EventPool_Get(handle)->severity) == HANDOFF_REJECTED)
             {
-                LogWarn("No primary queue defined for event code %d\r\n", receivedEvent.eventCode);
-                continue;
+                break; // Still full, wait for the next drain
             }
+            ring->head = (ring->head + 1) % OVERFLOW_RING_LENGTH;
+            ring->count--;
+            dispatcherStats.reoffered++;
+        }
+
+        if (ring->count == 0)
+        {
+            taskENTER_CRITICAL();
+            parkedDeptMask &= ~(1UL << dept);
+            taskEXIT_CRITICAL();
+        }
+    }
+
+    Dispatcher_UpdateSaturation();
+}
+
+/**
+ * @brief Parks an event that its department could not accept.
+ *
+ * The event is dropped (and its record released) only if the department's
+ * overflow ring is full as well.
+ *
+ * @param department Department the event waits for.
+ * @param handle Pool handle of the event.
+ */
+static void Dispatcher_Park(uint8_t department, EventHandle_t handle)
+{
+    OverflowRing_t *ring = &overflowRings[department];
+
+    if (ring->count >= OVERFLOW_RING_LENGTH)
+    {
+        LogError("Overflow ring [%s] full, event %d dropped.\r\n", Routing_DeptName(department), EventPool_Get(handle)->eventCode);
+        dispatcherStats.dropped++;
+        EventPool_Release(handle);
+        return;
+    }
 
-            // Check primary department queue status (check for available space)
-            UBaseType_t primaryQueueSpaces = uxQueueSpacesAvailable(xPrimaryQueue);
-            LogDebug("Primary Dept [%s] Queue Check: %lu spaces available.\r\n", primaryDeptName, primaryQueueSpaces);
+    ring->items[(ring->head + ring->count) % OVERFLOW_RING_LENGTH] = handle;
+    ring->count++;
+    dispatcherStats.parked++;
 
-            // Decide whether to send to primary or attempt redirect
-            if (primaryQueueSpaces > 0 || !attemptRedirect || xAlternativeQueue == NULL)
+    taskENTER_CRITICAL();
+    parkedDeptMask |= (1UL << department);
+    taskEXIT_CRITICAL();
+
+    // A unit may have drained the queue between the rejection and the flag
+    // being set; retry once so that window cannot strand the event.
+    Dispatcher_ReofferParked();
+}
+
+/**
+ * @brief Sends one routed event to its selected department.
+ *
+ * Falls back to the primary department if the selected alternative rejects it,
+ * and parks the event for the primary department if that rejects it too.
+ *
+ * @param handle Pool handle of the event to send.
+ * @param route Routing rule of the event.
+ * @param hop Selected hop within the route.
+ */
+static void Dispatcher_SendRouted(EventHandle_t handle, const RouteEntry_t *route, uint8_t hop)
+{
+    const EmergencyEvent_t *event = EventPool_Get(handle);
+    uint8_t primaryDept = route->hops[0].department;
+    uint8_t targetDept = route->hops[hop].department;
+    BaseType_t xStatus;
+
+    if (targetDept == primaryDept)
+    {
+        LogDebug("Dispatching event %d to Primary [%s].\r\n", event->eventCode, Routing_DeptName(primaryDept));
+    }
+    else
+    {
+        LogInfo("Redirecting event %d from [%s] to Alternative [%s].\r\n", event->eventCode, Routing_DeptName(primaryDept), Routing_DeptName(targetDept));
+    }
+
+    xStatus = Dispatcher_Deliver(targetDept, handle, event->severity);
+    if (xStatus != pdPASS && targetDept != primaryDept)
+    {
+        // Fallback: Try sending to primary queue anyway if redirect fails
+        LogWarn("Redirect to [%s] failed, sending event %d back to Primary Queue [%s] to wait.\r\n", Routing_DeptName(targetDept), event->eventCode, Routing_DeptName(primaryDept));
+        xStatus = Dispatcher_Deliver(primaryDept, handle, event->severity);
+    }
+    if (xStatus != pdPASS)
+    {
+        LogWarn("Primary Queue [%s] full, parking event %d.\r\n", Routing_DeptName(primaryDept), event->eventCode);
+        Dispatcher_Park(primaryDept, handle);
+    }
+}
+
+/**
+ * @brief Logs the dispatcher counters accumulated since the previous report.
+ */
+static void Dispatcher_LogStats(DispatcherStats_t *lastReport)
+{
+    DispatcherStats_t now;
+    uint32_t events, switchesX100;
+
+    Dispatcher_GetStats(&now);
+    events = now.eventsReceived - lastReport->eventsReceived;
+    if (events > 0)
+    {
+        switchesX100 = ((now.contextSwitches - lastReport->contextSwitches) * 100U) / events;
+        LogInfo("Dispatcher: %lu events, %lu wake-ups, %lu.%02lu ctx switches/event\r\n",
+                events, now.wakeups - lastReport->wakeups, switchesX100 / 100U, switchesX100 % 100U);
+    }
+    if (now.parked != lastReport->parked || now.dropped != lastReport->dropped)
+    {
+        LogInfo("Dispatcher overflow: %lu parked, %lu re-offered, %lu dropped\r\n",
+                now.parked - lastReport->parked, now.reoffered - lastReport->reoffered, now.dropped - lastReport->dropped);
+    }
+    if (now.preemptions != lastReport->preemptions)
+    {
+        LogInfo("Pre-emption: %lu units interrupted for a more severe call\r\n", now.preemptions - lastReport->preemptions);
+    }
+    if (events > 0)
+    {
+        EventGeneratorIsrStats_t isr;
+
+        EventGenerator_GetIsrStats(&isr);
+        if (isr.calls > 0)
+        {
+            LogInfo("TIM2 ISR (%s RNG): avg %lu cycles, max %lu cycles (%lu calls)\r\n",
+                    (RNG_SERVICE_MODE == RNG_SERVICE_POLLED) ? "polled" : "ring",
+                    (uint32_t)(isr.totalCycles / isr.calls), isr.maxCycles, isr.calls);
+        }
+    }
+    if (Admission_GetLevel() != SATURATION_NORMAL)
+    {
+        AdmissionStats_t adm;
+
+        Admission_GetStats(&adm);
+        LogInfo("Admission [%s]: %lu admitted, %lu downgraded, %lu deferred, shed %lu policy / %lu timeout / %lu defer-full / %lu queue-full / %lu no-record\r\n",
+                Admission_LevelName(Admission_GetLevel()), adm.admitted, adm.downgraded, adm.deferred,
+                adm.shedSaturation, adm.shedDeferTimeout, adm.shedDeferFull, adm.shedQueueFull, adm.shedPoolEmpty);
+    }
+    *lastReport = now;
+}
+
+/**
+ * @brief Routes and delivers one batch of events drained from the input rings.
+ *
+ * Takes one snapshot of all department occupancy, makes every routing decision
+ * against it (accounting for the events already assigned earlier in the batch),
+ * and only then issues the deliveries.
+ *
+ * @param batch Event handles, most severe first.
+ * @param batchCount Number of handles in the batch.
+ */
+static void Dispatcher_ProcessBatch(const EventHandle_t *batch, UBaseType_t batchCount)
+{
+    EmergencyEvent_t *event;
+    const RouteEntry_t *batchRoute[DISPATCHER_BATCH_SIZE]; // Routing rule per event (NULL = unknown code)
+    uint8_t batchHop[DISPATCHER_BATCH_SIZE];               // Selected hop per event
+    DeptLoad_t deptLoad[DEPT_COUNT];                       // Queue occupancy snapshot for routing
+    DeptUnitStatus_t unitStatus;
+    UnitScan_t unitScan;
+    UBaseType_t i;
+    uint8_t dept;
+
+    dispatcherStats.eventsReceived += batchCount;
+
+    // 1. One consistent snapshot of all department occupancy for the whole batch
+    taskENTER_CRITICAL();
+    for (dept = 0; dept < DEPT_COUNT; ++dept)
+    {
+        deptLoad[dept].freeSlots = PrioQueue_SpacesAvailable(*deptQueues[dept]);
+        deptLoad[dept].queued = PrioQueue_MessagesWaiting(*deptQueues[dept]) + overflowRings[dept].count;
+        ResourceUnit_GetStatus(dept, &unitStatus);
+        deptLoad[dept].idleUnits = unitStatus.idleUnits;
+        deptLoad[dept].numUnits = unitStatus.numUnits;
+        deptLoad[dept].meanServiceTicks = unitStatus.meanServiceTicks;
+        if (overflowRings[dept].count > 0)
+        {
+            deptLoad[dept].freeSlots = 0; // New events queue up behind the parked ones
+        }
+    }
+    taskEXIT_CRITICAL();
+
+    // Unit phases are published in lock-free state arrays: scan them outside the critical section
+    for (dept = 0; dept < DEPT_COUNT; ++dept)
+    {
+        ResourceUnit_ScanUnits(dept, &unitScan);
+        deptLoad[dept].nearlyFreeUnits = unitScan.nearlyFreeUnits;
+        deptLoad[dept].soonestClearTicks = unitScan.soonestClearTicks;
+    }
+
+    // 2. Make every routing decision against the snapshot
+    for (i = 0; i < batchCount; ++i)
+    {
+        event = EventPool_Get(batch[i]);
+        event->stamps[EVENT_STAGE_DISPATCHED] = TimeBase_SimNowUs();
+        LogDebug("Dispatcher received event code %d (severity %d) from %s district %d\r\n", event->eventCode, event->severity, District_Name(event->district), event->district);
+
+        batchRoute[i] = Routing_Lookup(event->eventCode);
+        if (batchRoute[i] == NULL)
+        {
+            LogWarn("Dispatcher received unknown event code: %d\r\n", event->eventCode);
+            EventPool_Release(batch[i]);
+            continue; // Skip processing this unknown event
+        }
+
+        batchHop[i] = Routing_SelectHop(batchRoute[i], deptLoad);
+        dept = batchRoute[i]->hops[batchHop[i]].department;
+        if (deptLoad[dept].idleUnits > 0)
+        {
+            deptLoad[dept].idleUnits--; // Will be handed straight to a unit
+        }
+        else
+        {
+            if (deptLoad[dept].freeSlots > 0)
             {
-                // Send to primary if:
-                // 1. Primary queue has space available, OR
-                // 2. Redirection is not allowed for this event type, OR
-                // 3. No alternative queue is defined.
-                LogDebug("Dispatching event %d to Primary [%s].\r\n", receivedEvent.eventCode, primaryDeptName);
-                xStatus = xQueueSend(xPrimaryQueue, &receivedEvent, xSendTicksToWait);
-                if (xStatus != pdPASS)
-                {
-                    LogError("Failed to send event %d to Primary Queue [%s] (Timeout?)\r\n", receivedEvent.eventCode, primaryDeptName);
-                }
+                deptLoad[dept].freeSlots--;
             }
-            else
+            deptLoad[dept].queued++;
+        }
+    }
+
+    // 3. Issue the deliveries
+    for (i = 0; i < batchCount; ++i)
+    {
+        if (batchRoute[i] != NULL)
+        {
+            Dispatcher_SendRouted(batch[i], batchRoute[i], batchHop[i]);
+        }
+    }
+
+    // 4. Publish the resulting pressure to admission control
+    Dispatcher_UpdateSaturation();
+}
+
+/**
+ * @brief Routes every event in the input rings, one batch at a time.
+ *
+ * Each batch is filled from the most severe non-empty ring down, so a critical
+ * call waits for at most the batch being routed, however many less severe calls
+ * are pending. Equal severities keep arrival order.
+ */
+static void Dispatcher_DrainInput(void)
+{
+    EventHandle_t batch[DISPATCHER_BATCH_SIZE]; // Event handles drained in one pass, most severe first
+    UBaseType_t batchCount;
+    uint8_t severity;
+
+    do
+    {
+        // 1. Take up to one batch without blocking. A batch that is not full
+        //    has seen every ring empty, the final check the wake-up relies on.
+        batchCount = 0;
+        for (severity = NUM_SEVERITY_LEVELS; severity > 0 && batchCount < DISPATCHER_BATCH_SIZE; --severity)
+        {
+            while (batchCount < DISPATCHER_BATCH_SIZE && SpscRing_Pop(&inputRings[severity - 1U], &batch[batchCount]) == pdPASS)
             {
-                // Primary queue is full AND redirection is allowed AND alternative exists
-                LogWarn("Primary Dept [%s] is full. Checking Alternative [%s]...\r\n", primaryDeptName, alternativeDeptName);
-
-                // Check alternative department queue status (check for available space)
-                UBaseType_t alternativeQueueSpaces = uxQueueSpacesAvailable(xAlternativeQueue);
-                LogDebug("Alternative Dept [%s] Queue Check: %lu spaces available.\r\n", alternativeDeptName, alternativeQueueSpaces);
-
-                if (alternativeQueueSpaces > 0)
-                {
-                    // Alternative queue has space, redirect the call
-                    LogInfo("Redirecting event %d from [%s] to Alternative [%s].\r\n", receivedEvent.eventCode, primaryDeptName, alternativeDeptName);
-
-                    xStatus = xQueueSend(xAlternativeQueue, &receivedEvent, xSendTicksToWait);
-                    if (xStatus != pdPASS)
-                    {
-                        LogError("Failed to send event %d to Alternative Queue [%s] (Timeout?)\r\n", receivedEvent.eventCode, alternativeDeptName);
-                        // Fallback: Try sending to primary queue anyway if redirect fails
-                        LogWarn("Redirect failed, sending event %d back to Primary Queue [%s] to wait.\r\n", receivedEvent.eventCode, primaryDeptName);
-                        xStatus = xQueueSend(xPrimaryQueue, &receivedEvent, xSendTicksToWait);
-                        if (xStatus != pdPASS)
-                        {
-                            LogError("Fallback send to Primary Queue [%s] also failed! Event %d lost.\r\n", primaryDeptName, receivedEvent.eventCode);
-                        }
-                    }
-                }
-                else
-                {
-                    // Alternative queue is full, send to original primary queue
-                    LogWarn("Alternative Dept [%s] is full. Sending event %d to Primary Queue [%s] to wait.\r\n", alternativeDeptName, receivedEvent.eventCode, primaryDeptName);
-                    xStatus = xQueueSend(xPrimaryQueue, &receivedEvent, xSendTicksToWait);
-                    if (xStatus != pdPASS)
-                    {
-                        LogError("Failed to send event %d to Primary Queue [%s] even when busy (Timeout?) Event lost.\r\n", receivedEvent.eventCode, primaryDeptName);
-                    }
-                }
+                batchCount++;
             }
         }
-        // No else needed for xQueueReceive error with portMAX_DELAY,
-        // unless the queue handle itself is invalid.
+
+        if (batchCount > 0)
+        {
+            Dispatcher_ProcessBatch(batch, batchCount);
+        }
+    } while (batchCount == DISPATCHER_BATCH_SIZE);
+}
+
+/**
+ * @brief Logs the dispatcher counters and department utilization once every
+ *        DISPATCHER_STATS_LOG_PERIOD_MS.
+ */
+static void Dispatcher_PeriodicReport(void)
+{
+    static DispatcherStats_t lastReport = {0};
+    static TimeStamp_t lastReportUs = 0;
+    const TimeStamp_t nowUs = TimeBase_NowUs();
+
+    if ((nowUs - lastReportUs) >= (uint64_t)DISPATCHER_STATS_LOG_PERIOD_MS * TIME_US_PER_MS)
+    {
+        lastReportUs = nowUs;
+        Dispatcher_LogStats(&lastReport);
+        Utilization_Dump();
+    }
+}
+
+#if PREEMPTION_MODE == PREEMPTION_AB
+/**
+ * @brief Flips pre-emption every PREEMPTION_AB_PERIOD_MS (timer service task).
+ *
+ * Both settings get the same time, and so the same offered load, even when the
+ * system is too quiet for the dispatcher to wake up regularly.
+ */
+static void Dispatcher_PreemptionAbSwitch(TimerHandle_t xTimer)
+{
+    (void)xTimer;
+    ResourceUnit_SetPreemption(!ResourceUnit_GetPreemption());
+    LogInfo("Pre-emption %s for the next %u ms.\r\n", ResourceUnit_GetPreemption() ? "on" : "off", PREEMPTION_AB_PERIOD_MS);
+}
+#endif
+
+#if DISPATCHER_MODE == DISPATCHER_MODE_DEFERRED
+/**
+ * @brief Routes every event posted by the ISR since the last wake-up (timer service task).
+ */
+static void Dispatcher_DeferredWork(void *pvParameter1, uint32_t ulParameter2)
+{
+    (void)pvParameter1;
+    (void)ulParameter2;
+    dispatcherStats.wakeups++;
+    Dispatcher_DrainInput();
+    Dispatcher_PeriodicReport();
+}
+
+/**
+ * @brief Re-offers parked events after a department drained (timer service task).
+ */
+static void Dispatcher_DeferredReoffer(void *pvParameter1, uint32_t ulParameter2)
+{
+    (void)pvParameter1;
+    (void)ulParameter2;
+    Dispatcher_ReofferParked();
+}
+#endif
+
+static void Dispatcher_Task(void *pvParameters)
+{
+    uint32_t notifiedBits = 0;
+
+    LogInfo("Dispatcher Task running (batch size %d).\r\n", DISPATCHER_BATCH_SIZE);
+
+    while (1)
+    {
+        // 1. Parked events are older than anything new, so re-offer them first
+        if (notifiedBits & DISPATCHER_NOTIFY_DRAIN)
+        {
+            Dispatcher_ReofferParked();
+        }
+
+        // 2. Drain the input rings until all are seen empty; a post after that
+        //    check finds its ring empty and notifies again.
+        Dispatcher_DrainInput();
+
+        // 3. Periodic report of wake-ups, context switches per event and overflow counters
+        Dispatcher_PeriodicReport();
+
+        // 4. Sleep until new input arrives or a department with parked events drains
+        xTaskNotifyWait(0, 0xFFFFFFFFUL, &notifiedBits, portMAX_DELAY);
+        dispatcherStats.wakeups++;
     }
 }
@@ -0,0 +1,185 @@
+/**
+ * @file district.c
+ * @brief Multi-district event sources multiplexed onto one timer.
+ *
+ * District i uses profile districtProfiles[i % profile count]: a Poisson
+ * arrival process with the profile's mean delay and the profile's event mix.
+ * To add a kind of district: define its mix and add one line to
+ * districtProfiles[].
+ *
+ * The heap stores the arrival time next to the district ID, so a sift-down
+ * only touches heap nodes; rescheduling the root is the only heap operation
+ * the ISR ever performs.
+ *
+ * @date October 15, 2026
+ * @author shayb
+ */
+
+#include "district.h"
+#include "arrival_model.h"
+#include "event_mix.h"
+#include "rng_service.h"
+
+/**
+ * @def MIX
+ * @brief Builds a mix reference from a weight array, counting the codes at compile time.
+ */
+#define MIX(weightArray) (weightArray), (uint8_t)(sizeof(weightArray) / sizeof((weightArray)[0]))
+
+/**
+ * @brief Arrival rate and call mix shared by every district of one kind.
+ */
+typedef struct
+{
+    const char *name;
+    uint32_t meanDelayUs;           // Mean time between calls in one district of this kind
+    const EventMixWeight_t *weights; // Event mix
+    uint8_t numWeights;
+} DistrictProfile_t;
+
+/**
+ * @brief Heap node: next arrival of one district.
+ */
+typedef struct
+{
+    TimeStamp_t dueUs; // Generator time of the next call
+    uint8_t district;
+} DistrictHeapNode_t;
+
+// --- Event Mixes ---
+
+static const EventMixWeight_t downtownMix[] = {
+    {EVENT_CODE_POLICE, 6},
+    {EVENT_CODE_AMBULANCE, 3},
+    {EVENT_CODE_FIRE_DEPT, 1},
+};
+
+static const EventMixWeight_t harborMix[] = {
+    {EVENT_CODE_POLICE, 3},
+    {EVENT_CODE_AMBULANCE, 3},
+    {EVENT_CODE_FIRE_DEPT, 4},
+};
+
+static const EventMixWeight_t suburbMix[] = {
+    {EVENT_CODE_POLICE, 3},
+    {EVENT_CODE_AMBULANCE, 5},
+    {EVENT_CODE_FIRE_DEPT, 2},
+};
+
+static const EventMixWeight_t industrialMix[] = {
+    {EVENT_CODE_POLICE, 2},
+    {EVENT_CODE_AMBULANCE, 3},
+    {EVENT_CODE_FIRE_DEPT, 5},
+};
+
+// --- District Profiles (assigned round-robin to the districts) ---
+
+static const DistrictProfile_t districtProfiles[] = {
+    {"Downtown", 8000000UL, MIX(downtownMix)},
+    {"Harbor", 20000000UL, MIX(harborMix)},
+    {"Suburb", 30000000UL, MIX(suburbMix)},
+    {"Industrial", 25000000UL, MIX(industrialMix)},
+};
+
+#define DISTRICT_PROFILE_COUNT (sizeof(districtProfiles) / sizeof(districtProfiles[0]))
+
+static EventMixTable_t profileMixTables[DISTRICT_PROFILE_COUNT]; // Built by District_Init
+static DistrictHeapNode_t heap[DISTRICT_COUNT];                   // Min-heap on dueUs (ISR only after init)
+
+// --- Private Functions ---
+
+static inline const DistrictProfile_t *District_Profile(uint8_t district)
+{
+    return &districtProfiles[district % DISTRICT_PROFILE_COUNT];
+}
+
+/**
+ * @brief Draws the time from one call of a district to its next.
+ */
+static inline uint32_t District_DrawDelayUs(uint8_t district, uint32_t randomValue)
+{
+#if DISTRICT_COUNT == 1
+    (void)district;
+    return ArrivalModel_NextDelayUsFromISR(randomValue); // City-wide source: selected arrival model
+#else
+    return ArrivalModel_ExpDelayUsFromISR(District_Profile(district)->meanDelayUs, randomValue);
+#endif
+}
+
+/**
+ * @brief Moves the node at index i down until the heap property holds.
+ */
+static void District_SiftDown(uint16_t i)
+{
+    const DistrictHeapNode_t node = heap[i];
+    uint16_t child;
+
+    while ((child = (uint16_t)(2U * i + 1U)) < DISTRICT_COUNT)
+    {
+        if (child + 1U < DISTRICT_COUNT && heap[child + 1U].dueUs < heap[child].dueUs)
+        {
+            child++; // Earlier of the two children
+        }
+        if (heap[child].dueUs >= node.dueUs)
+        {
+            break;
+        }
+        heap[i] = heap[child];
+        i = child;
+    }
+    heap[i] = node;
+}
+
+// --- Public Functions ---
+
+void District_Init(void)
+{
+    uint16_t i;
+
+    for (i = 0; i < DISTRICT_PROFILE_COUNT; ++i)
+    {
+        (void)EventMix_Build(&profileMixTables[i], districtProfiles[i].weights, districtProfiles[i].numWeights);
+    }
+
+    for (i = 0; i < DISTRICT_COUNT; ++i)
+    {
+        heap[i].district = (uint8_t)i;
+        heap[i].dueUs = District_DrawDelayUs((uint8_t)i, RngService_Next());
+    }
+    for (i = DISTRICT_COUNT / 2U; i > 0; --i)
+    {
+        District_SiftDown((uint16_t)(i - 1U));
+    }
+}
+
+uint8_t District_PeekFromISR(TimeStamp_t *pDueUs)
+{
+    *pDueUs = heap[0].dueUs;
+    return heap[0].district;
+}
+
+void District_RescheduleFromISR(uint32_t randomValue)
+{
+    heap[0].dueUs += District_DrawDelayUs(heap[0].district, randomValue);
+    District_SiftDown(0);
+}
+
+uint8_t District_NextCodeFromISR(uint8_t district, uint32_t randomValue)
+{
+#if DISTRICT_COUNT == 1
+    (void)district;
+    return EventMix_NextCodeFromISR(randomValue); // City-wide source: active mix
+#else
+    return EventMix_DrawFromTable(&profileMixTables[district % DISTRICT_PROFILE_COUNT], randomValue);
+#endif
+}
+
+const char *District_Name(uint8_t district)
+{
+#if DISTRICT_COUNT == 1
+    (void)district;
+    return "City";
+#else
+    return (district < DISTRICT_COUNT) ? District_Profile(district)->name : "Unknown";
+#endif
+}
@@ -7,6 +7,14 @@
  * It uses a hardware timer (TIM2) and a random number generator (RNG) to determine event codes
  * and delays between events.
  *
+ * TIM2 counts at EVENT_TIMER_CLOCK_HZ and its auto-reload is reprogrammed on every
+ * update for the exact time to the next arrival, so there is one interrupt per
+ * event instead of a fixed-rate tick. The counter keeps running across updates,
+ * so arrival times do not drift by the interrupt latency.
+ *
+ * All generator timing (arrivals, deferral, trace time) is in simulated
+ * microseconds; only EventGenerator_ArmTimer() divides by the time dilation.
+ *
  * @date April 17, 2025
  * @author shayb
  */
@@ -17,27 +25,202 @@
 
 #include "main.h" // For HAL types and HAL function prototypes (TIM, RNG)
 #include "FreeRTOS.h"
-#include "queue.h" // For xQueueSendFromISR
+#include "task.h"       // For taskENTER_CRITICAL
+#include "event_pool.h" // For EventPool_AllocFromISR
+#include "dispatcher.h" // For Dispatcher_PostFromISR
+#include "admission.h"  // For admission decisions and shed counters
+#include "time_base.h"  // For TimeBase_SimNowUs and the time dilation
+#include "rng_service.h" // For RngService_NextFromISR
+#include "arrival_model.h" // For ArrivalModel_NextDelayUsFromISR
+#include "trace.h"          // For trace replay and recording
+#include "event_mix.h"      // For EventMix_Init
+#include "district.h"       // For the per-district arrival heap
 
 // --- HAL Handles (Assumed defined globally in main.c or stm32f7xx_hal_msp.c) ---
-extern TIM_HandleTypeDef htim2; // Timer used for periodic interrupt
-extern RNG_HandleTypeDef hrng;  // Random Number Generator handle
-
-// --- RTOS Handles (Assumed defined globally in main.c or queues.c) ---
-extern QueueHandle_t xDispatcherQueue; // Queue to send events to
+extern TIM_HandleTypeDef htim2; // One-shot event timer
+extern RNG_HandleTypeDef hrng;  // Random Number Generator handle (owned by rng_service.c)
 
 // --- Static Variables ---
 // These maintain state across timer interrupt calls
-static volatile uint32_t ticksUntilNextEvent = MIN_EVENT_DELAY_TICKS; // Start with min delay for first event
-static volatile uint32_t currentTickCount = 0;
+static uint32_t usUntilNextEvent = MIN_EVENT_DELAY_US; // Time left until the next arrival
+static uint32_t programmedUs = MIN_EVENT_DELAY_US;     // Simulated length of the timer period now running
+static TimeStamp_t generatorTimeUs = 0;                // Sum of completed timer periods (64-bit, never wraps)
+static uint8_t generationStopped = 0;                  // Set when a non-looping replay has ended
+static uint8_t replayCode = 0;                         // Next call taken from the trace (replay only)
+static uint8_t replaySeverity = 0;
+
+/**
+ * @brief A call held back by admission control.
+ */
+typedef struct
+{
+    EventHandle_t handle;
+    TimeStamp_t deferredAt; // generatorTimeUs when first deferred
+} DeferredCall_t;
+
+static DeferredCall_t deferredCalls[ADMISSION_DEFER_SLOTS]; // Oldest first
+static uint8_t deferredCallCount = 0;
+
+static EventGeneratorIsrStats_t isrStats = {0}; // TIM2 callback execution time
+
+// --- Private Functions ---
+
+/**
+ * @brief Applies admission control to a call and posts it if admitted (ISR context).
+ *
+ * @param handle Pool handle of the call.
+ * @param wasDeferred Non-zero if the call comes from the defer buffer.
+ * @param pxHigherPriorityTaskWoken Passed through to the dispatcher.
+ * @return pdTRUE if the call was consumed (posted or shed), pdFALSE if it must be deferred.
+ */
+static BaseType_t EventGenerator_AdmitFromISR(EventHandle_t handle, uint8_t wasDeferred, BaseType_t *pxHigherPriorityTaskWoken)
+{
+    EmergencyEvent_t *event = EventPool_Get(handle);
+    AdmissionAction_t action = Admission_Decide(event->severity);
+
+    switch (action)
+    {
+    case ADMIT_DEFER:
+        if (!wasDeferred)
+        {
+            Admission_CountAdmit(ADMIT_DEFER, 0);
+        }
+        return pdFALSE;
+    case ADMIT_SHED:
+        Admission_CountShed(SHED_SATURATION);
+        EventPool_ReleaseFromISR(handle);
+        return pdTRUE;
+    case ADMIT_DOWNGRADE:
+        event->severity--; // Policy only downgrades severities above LOW
+        break;
+    case ADMIT_ACCEPT:
+    default:
+        break;
+    }
+
+    if (Dispatcher_PostFromISR(handle, event->severity, pxHigherPriorityTaskWoken) != pdPASS)
+    {
+        // Dispatcher input full: shed it and give the record back to the pool
+        Admission_CountShed(SHED_QUEUE_FULL);
+        EventPool_ReleaseFromISR(handle);
+        return pdTRUE;
+    }
+    Admission_CountAdmit(action, wasDeferred);
+    return pdTRUE;
+}
+
+/**
+ * @brief Re-evaluates deferred calls, oldest first (ISR context).
+ *
+ * Runs on every timer interrupt; while calls are held the timer fires at least
+ * every ADMISSION_DEFER_RETRY_US.
+ */
+static void EventGenerator_RetryDeferredFromISR(BaseType_t *pxHigherPriorityTaskWoken)
+{
+    uint8_t i, kept = 0;
+
+    for (i = 0; i < deferredCallCount; ++i)
+    {
+        DeferredCall_t call = deferredCalls[i];
+
+        if (EventGenerator_AdmitFromISR(call.handle, 1, pxHigherPriorityTaskWoken))
+        {
+            continue; // Posted or shed
+        }
+        if ((generatorTimeUs - call.deferredAt) >= ADMISSION_DEFER_MAX_US)
+        {
+            Admission_CountShed(SHED_DEFER_TIMEOUT);
+            EventPool_ReleaseFromISR(call.handle);
+            continue;
+        }
+        deferredCalls[kept++] = call;
+    }
+    deferredCallCount = kept;
+}
+
+/**
+ * @brief Arms TIM2 to update after the given delay (ISR context, or before the timer runs).
+ *
+ * Called right after an update, while the counter has only advanced by the
+ * interrupt latency. If that latency already exceeds the new period, the
+ * counter is moved to the reload value so the update fires on the next count
+ * instead of after a full 32-bit wrap.
+ *
+ * @param delayUs Delay in simulated microseconds. The wall-clock period is
+ *                rounded up, and programmedUs records the simulated time it
+ *                really covers.
+ */
+static void EventGenerator_ArmTimer(uint32_t delayUs)
+{
+    TIM_TypeDef *tim = htim2.Instance;
+    uint32_t wallUs = (uint32_t)TimeBase_SimToWallUs(delayUs);
+    uint64_t simPeriodUs;
+
+    if (wallUs < 2U)
+    {
+        wallUs = 2U; // ARR = 0 would update on every count
+    }
+    simPeriodUs = (uint64_t)wallUs * TimeBase_GetDilation();
+    programmedUs = (simPeriodUs > UINT32_MAX) ? UINT32_MAX : (uint32_t)simPeriodUs;
+    tim->ARR = wallUs - 1U; // Preload disabled: takes effect immediately
+    if (tim->CNT >= tim->ARR)
+    {
+        tim->CNT = tim->ARR; // Overran already, fire as soon as possible
+    }
+}
+
+/**
+ * @brief Returns the time from now to the earliest pending district arrival.
+ */
+static uint32_t EventGenerator_UsUntilDistrictDue(void)
+{
+    TimeStamp_t dueUs;
+
+    (void)District_PeekFromISR(&dueUs);
+    if (dueUs <= generatorTimeUs)
+    {
+        return 0; // Due already (several districts at the same microsecond)
+    }
+    return ((dueUs - generatorTimeUs) > UINT32_MAX) ? UINT32_MAX : (uint32_t)(dueUs - generatorTimeUs);
+}
+
+/**
+ * @brief Determines the time to the next arrival, after the current call was generated.
+ *
+ * While a trace is replaying, the delay (and the next call) comes from the
+ * trace. Otherwise the district that just called draws its next arrival, and
+ * the earliest district in the heap is next.
+ *
+ * @return Delay in microseconds (0 = another call is due now), or UINT32_MAX
+ *         once a non-looping replay has ended (generationStopped is set).
+ */
+static uint32_t EventGenerator_NextDelayUs(void)
+{
+    uint32_t delayUs;
+
+    if (TraceReplay_IsActive())
+    {
+        if (TraceReplay_NextFromISR(&delayUs, &replayCode, &replaySeverity) != pdPASS)
+        {
+            generationStopped = 1; // Replay over: the timer only runs on for deferred calls
+            return UINT32_MAX;
+        }
+        return (delayUs > 0) ? delayUs : 1U; // Simultaneous calls: back to back
+    }
+
+    // O(log N): reschedule the district at the top of the heap
+    District_RescheduleFromISR(RngService_NextFromISR());
+    return EventGenerator_UsUntilDistrictDue();
+}
 
 // --- Public Functions ---
 
 /**
  * @brief Initializes the Event Generator module.
  *
- * Starts the hardware timer (TIM2) in interrupt mode. Assumes TIM2 and RNG peripherals
- * have already been initialized by CubeMX (MX_TIM2_Init, MX_RNG_Init).
+ * Reconfigures TIM2 as the one-shot event timer (EVENT_TIMER_CLOCK_HZ, no
+ * auto-reload preload) and starts it in interrupt mode. Assumes TIM2 and RNG
+ * peripherals have already been initialized by CubeMX (MX_TIM2_Init, MX_RNG_Init).
  *
  * @retval pdPASS if the timer started successfully, pdFAIL otherwise.
  */
@@ -46,7 +229,7 @@ BaseType_t EventGenerator_Init(void)
     printf("Initializing Event Generator...\r\n");
 
     // Ensure necessary handles are valid before starting
-    // (Ideally check hrng and xDispatcherQueue too if possible at this stage)
+    // (Ideally check hrng too if possible at this stage)
     if (htim2.Instance == NULL)
     {
         printf("TIM2 Handle not initialized before EventGenerator_Init!\r\n");
@@ -57,15 +240,53 @@ BaseType_t EventGenerator_Init(void)
         printf("RNG Handle not initialized before EventGenerator_Init!\r\n");
         return pdFAIL;
     }
-    if (xDispatcherQueue == NULL)
+
+    // TIM2 sits on APB1; its kernel clock is doubled whenever APB1 is divided
+    uint32_t timerClockHz = HAL_RCC_GetPCLK1Freq();
+    if ((RCC->CFGR & RCC_CFGR_PPRE1) != RCC_HCLK_DIV1)
     {
-        printf("Dispatcher Queue handle is NULL during EventGenerator_Init!\r\n");
-        return pdFAIL;
+        timerClockHz *= 2U;
     }
 
+    // Precompute the arrival model and event mix tables before the first draw
+    ArrivalModel_Init();
+    EventMix_Init();
+
     // Reset state variables
-    ticksUntilNextEvent = MIN_EVENT_DELAY_TICKS; // Generate first event quickly
-    currentTickCount = 0;
+    generatorTimeUs = 0;
+    generationStopped = 0;
+    deferredCallCount = 0;
+
+    // Every district draws its first arrival; the earliest one arms the timer
+    District_Init();
+    usUntilNextEvent = EventGenerator_UsUntilDistrictDue();
+    if (usUntilNextEvent == 0)
+    {
+        usUntilNextEvent = 1U;
+    }
+
+#if TRACE_REPLAY_ENABLE
+    // Replay the flash trace, unless a trace was loaded already (a host build maps a file)
+    if (!TraceReplay_IsActive() && TraceReplay_Load(traceFlashImage, traceFlashImageWords * sizeof(uint32_t)) != pdPASS)
+    {
+        printf("Flash trace invalid, using the arrival model.\r\n");
+    }
+#endif
+    // Replaying: the first record gives the first call and its delay
+    if (TraceReplay_IsActive())
+    {
+        usUntilNextEvent = EventGenerator_NextDelayUs();
+        printf("Event Generator replaying a trace.\r\n");
+    }
+
+    // Re-time the timer: 1 us counts, reload written directly, update only on overflow
+    __HAL_TIM_DISABLE(&htim2);
+    __HAL_TIM_SET_PRESCALER(&htim2, (timerClockHz / EVENT_TIMER_CLOCK_HZ) - 1U);
+    htim2.Instance->CR1 = (htim2.Instance->CR1 & ~TIM_CR1_ARPE) | TIM_CR1_URS;
+    htim2.Instance->EGR = TIM_EGR_UG; // Load the prescaler now (no interrupt thanks to URS)
+    __HAL_TIM_SET_COUNTER(&htim2, 0);
+    EventGenerator_ArmTimer(usUntilNextEvent);
+    __HAL_TIM_CLEAR_FLAG(&htim2, TIM_FLAG_UPDATE);
 
     // Start the timer in Interrupt mode
     if (HAL_TIM_Base_Start_IT(&htim2) != HAL_OK)
@@ -74,10 +295,17 @@ BaseType_t EventGenerator_Init(void)
         return pdFAIL; // Indicate failure
     }
 
-    printf("Event Generator Timer (TIM2) started.\r\n");
+    printf("Event Generator Timer (TIM2) started, arrival model: %s.\r\n", ArrivalModel_Name(ArrivalModel_GetActive()));
     return pdPASS; // Indicate success
 }
 
+void EventGenerator_GetIsrStats(EventGeneratorIsrStats_t *stats)
+{
+    taskENTER_CRITICAL(); // Masks TIM2 (priority 5) while copying
+    *stats = isrStats;
+    taskEXIT_CRITICAL();
+}
+
 // --- HAL Callback Implementation ---
 
 /**
@@ -101,58 +329,121 @@ void HAL_TIM_PeriodElapsedCallback(TIM_HandleTypeDef *htim)
     {
         BaseType_t xHigherPriorityTaskWoken = pdFALSE; // Must be initialised pdFALSE for FromISR calls
         uint32_t randomValue;                          // To store RNG output
+        const uint32_t entryCycles = DWT->CYCCNT;      // For the ISR execution time statistics
+        uint32_t isrCycles;
 
-        currentTickCount++;
+        // The period that just ended has passed
+        generatorTimeUs += programmedUs;
+        usUntilNextEvent = (usUntilNextEvent > programmedUs) ? (usUntilNextEvent - programmedUs) : 0;
 
-        // Check if it's time to generate the event
-        if (currentTickCount >= ticksUntilNextEvent)
+        // Calls held back by admission control get another chance
+        if (deferredCallCount > 0)
+        {
+            EventGenerator_RetryDeferredFromISR(&xHigherPriorityTaskWoken);
+        }
+
+        // Generate every call that is due (several districts may share a microsecond)
+        while (usUntilNextEvent == 0 && !generationStopped)
         {
             // --- Event Generation ---
-            EmergencyEvent_t eventToSend;
+            uint8_t eventCode, severity, district = 0;
+            TimeStamp_t dueUs;
 
-            // 1. Generate the event CODE (1, 2, or 3) using RNG
-            if (HAL_RNG_GenerateRandomNumber(&hrng, &randomValue) == HAL_OK)
+            // 1. The call itself: recorded in the trace, or drawn from the prefetched random ring
+            if (TraceReplay_IsActive())
             {
-                // Scale 32-bit random to 1-3
-                eventToSend.eventCode = (randomValue % 3) + 1; // Assumes codes 1, 2, 3
+                eventCode = replayCode;
+                severity = replaySeverity;
             }
             else
             {
-                eventToSend.eventCode = EVENT_CODE_POLICE; // Default to Police on RNG error
+                // Weighted event type from the calling district's alias table (uses all 32 bits)
+                district = District_PeekFromISR(&dueUs);
+                eventCode = District_NextCodeFromISR(district, RngService_NextFromISR());
+                // Severity from a fresh word so it is independent of the code
+                randomValue = RngService_NextFromISR();
+                severity = randomValue % NUM_SEVERITY_LEVELS;
             }
+            // Every offered call is recorded, even if it is later shed
+            TraceRecorder_RecordFromISR((uint32_t)generatorTimeUs, eventCode, severity); // Only deltas are stored
 
-            // --- Send Event to Queue ---
-            // Check queue handle validity just in case, though it should be valid after Init
-            if (xDispatcherQueue != NULL)
+            // Take a record from the pool; only its handle travels through the queues
+            EventHandle_t eventHandle = EventPool_AllocFromISR();
+
+            if (eventHandle != EVENT_HANDLE_INVALID)
             {
-                BaseType_t xQueueSendStatus = xQueueSendFromISR(xDispatcherQueue, &eventToSend, &xHigherPriorityTaskWoken);
+                EmergencyEvent_t *eventToSend = EventPool_Get(eventHandle);
+
+                // 2. Stamp the generation time (start of every latency measurement)
+                eventToSend->stamps[EVENT_STAGE_GENERATED] = TimeBase_SimNowUs();
+                eventToSend->timeStamp = xTaskGetTickCountFromISR();
+                eventToSend->eventCode = eventCode;
+                eventToSend->severity = severity;
+                eventToSend->district = district;
+                eventToSend->sceneUs = 0;
+                eventToSend->sceneDoneUs = 0;
+                eventToSend->requeues = 0;
 
-                if (xQueueSendStatus != pdPASS)
+                // --- Admission Control, then Send Event to Dispatcher ---
+                if (!EventGenerator_AdmitFromISR(eventHandle, 0, &xHigherPriorityTaskWoken))
                 {
-                    // Queue is full! Handle this scenario.
-                    // Again, logging is hard from ISR. Increment counter? Set flag?
-                    // For now, the event is lost if the dispatcher queue is full.
+                    if (deferredCallCount < ADMISSION_DEFER_SLOTS)
+                    {
+                        deferredCalls[deferredCallCount].handle = eventHandle;
+                        deferredCalls[deferredCallCount].deferredAt = generatorTimeUs;
+                        deferredCallCount++;
+                    }
+                    else
+                    {
+                        Admission_CountShed(SHED_DEFER_FULL);
+                        EventPool_ReleaseFromISR(eventHandle);
+                    }
                 }
             }
+            else
+            {
+                // Pool exhausted (every record is in flight), the event is lost
+                Admission_CountShed(SHED_POOL_EMPTY);
+            }
 
             // --- Determine Delay for Next Event ---
-            if (HAL_RNG_GenerateRandomNumber(&hrng, &randomValue) == HAL_OK)
+            usUntilNextEvent = EventGenerator_NextDelayUs();
+        }
+
+        // --- Re-arm the Timer ---
+        // For the next arrival, or sooner if deferred calls need another look
+        if (generationStopped)
+        {
+            if (deferredCallCount == 0)
             {
-                // Scale the 32-bit random number to our delay range in ticks
-                ticksUntilNextEvent = (randomValue % DELAY_RANGE_TICKS) + MIN_EVENT_DELAY_TICKS;
+                // Replay over and nothing held back: no more work for this timer
+                (void)HAL_TIM_Base_Stop_IT(&htim2);
             }
             else
             {
-                // RNG Error - Handle it, maybe default delay or log error
-                ticksUntilNextEvent = MIN_EVENT_DELAY_TICKS; // Default to min delay on error
+                EventGenerator_ArmTimer(ADMISSION_DEFER_RETRY_US);
             }
+        }
+        else if (deferredCallCount > 0 && usUntilNextEvent > ADMISSION_DEFER_RETRY_US)
+        {
+            EventGenerator_ArmTimer(ADMISSION_DEFER_RETRY_US);
+        }
+        else
+        {
+            EventGenerator_ArmTimer(usUntilNextEvent);
+        }
 
-            // --- Reset Counter ---
-            currentTickCount = 0;
-
-            // --- Yield if Necessary ---
-            // If xQueueSendFromISR unblocked a task with higher priority than the interrupted task, yield.
-            portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+        // --- ISR Execution Time ---
+        isrCycles = DWT->CYCCNT - entryCycles;
+        isrStats.calls++;
+        isrStats.totalCycles += isrCycles;
+        if (isrCycles > isrStats.maxCycles)
+        {
+            isrStats.maxCycles = isrCycles;
         }
+
+        // --- Yield if Necessary ---
+        // If posting an event unblocked a task with higher priority than the interrupted task, yield.
+        portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
     }
 }
@@ -0,0 +1,133 @@
+/**
+ * @file event_mix.c
+ * @brief Implementation of the weighted event-type distribution (Walker alias method).
+ *
+ * Building a table (Vose's variant, integer only): every weight is scaled so the
+ * average column holds exactly 65536. Columns below average are paired with one
+ * above average, which donates the missing share and becomes the alias. Each
+ * column then holds at most two codes, so a draw picks a column uniformly and
+ * flips one biased coin.
+ *
+ * The column is chosen with a multiply-shift of the upper 16 random bits
+ * instead of a modulo, which keeps the bias below 2^-16 for any column count.
+ *
+ * @date October 15, 2026
+ * @author shayb
+ */
+
+#include "event_mix.h"
+#include "main.h" // For __DMB (CMSIS)
+
+#define EVENT_MIX_ONE 65536UL // Average column mass
+
+#define EVENT_MIX_ENTRY(threshold, aliasCode, code) \
+    (((uint32_t)(threshold) << 16) | ((uint32_t)(aliasCode) << 8) | (uint32_t)(code))
+
+static const EventMixWeight_t defaultWeights[] = {
+    {EVENT_CODE_POLICE, EVENT_MIX_WEIGHT_POLICE},
+    {EVENT_CODE_AMBULANCE, EVENT_MIX_WEIGHT_AMBULANCE},
+    {EVENT_CODE_FIRE_DEPT, EVENT_MIX_WEIGHT_FIRE_DEPT},
+};
+
+static EventMixTable_t defaultTable;
+static const EventMixTable_t *volatile activeTable = &defaultTable;
+
+// --- Public Functions ---
+
+void EventMix_Init(void)
+{
+    if (EventMix_Build(&defaultTable, defaultWeights, sizeof(defaultWeights) / sizeof(defaultWeights[0])) != pdPASS)
+    {
+        // All default weights zero: fall back to police only rather than an empty table
+        defaultTable.count = 1;
+        defaultTable.entries[0] = EVENT_MIX_ENTRY(0xFFFFU, EVENT_CODE_POLICE, EVENT_CODE_POLICE);
+    }
+    (void)EventMix_Activate(&defaultTable);
+}
+
+BaseType_t EventMix_Build(EventMixTable_t *table, const EventMixWeight_t *weights, uint8_t count)
+{
+    uint32_t scaled[EVENT_MIX_MAX_CODES]; // Column mass, EVENT_MIX_ONE on average
+    uint8_t small[EVENT_MIX_MAX_CODES], large[EVENT_MIX_MAX_CODES];
+    uint8_t numSmall = 0, numLarge = 0;
+    uint32_t sum = 0;
+    uint8_t i;
+
+    if (count == 0 || count > EVENT_MIX_MAX_CODES)
+    {
+        return pdFAIL;
+    }
+    for (i = 0; i < count; ++i)
+    {
+        sum += weights[i].weight;
+    }
+    if (sum == 0)
+    {
+        return pdFAIL;
+    }
+
+    // 1. Scale to column mass and split into under- and over-full columns
+    for (i = 0; i < count; ++i)
+    {
+        scaled[i] = (uint32_t)(((uint64_t)weights[i].weight * count * EVENT_MIX_ONE) / sum);
+        if (scaled[i] < EVENT_MIX_ONE)
+        {
+            small[numSmall++] = i;
+        }
+        else
+        {
+            large[numLarge++] = i;
+        }
+    }
+
+    // 2. Top up each under-full column from an over-full one
+    while (numSmall > 0 && numLarge > 0)
+    {
+        uint8_t s = small[--numSmall];
+        uint8_t l = large[numLarge - 1];
+
+        table->entries[s] = EVENT_MIX_ENTRY(scaled[s], weights[l].eventCode, weights[s].eventCode);
+        scaled[l] -= EVENT_MIX_ONE - scaled[s];
+        if (scaled[l] < EVENT_MIX_ONE)
+        {
+            numLarge--;
+            small[numSmall++] = l;
+        }
+    }
+
+    // 3. What is left is full up to rounding: the column always draws its own code
+    while (numLarge > 0)
+    {
+        i = large[--numLarge];
+        table->entries[i] = EVENT_MIX_ENTRY(0xFFFFU, weights[i].eventCode, weights[i].eventCode);
+    }
+    while (numSmall > 0)
+    {
+        i = small[--numSmall];
+        table->entries[i] = EVENT_MIX_ENTRY(0xFFFFU, weights[i].eventCode, weights[i].eventCode);
+    }
+
+    table->count = count;
+    return pdPASS;
+}
+
+const EventMixTable_t *EventMix_Activate(const EventMixTable_t *table)
+{
+    const EventMixTable_t *previous = activeTable;
+
+    __DMB(); // Table contents complete before the ISR can see the pointer
+    activeTable = table;
+    return previous;
+}
+
+uint8_t EventMix_NextCodeFromISR(uint32_t randomValue)
+{
+    return EventMix_DrawFromTable(activeTable, randomValue);
+}
+
+uint8_t EventMix_DrawFromTable(const EventMixTable_t *table, uint32_t randomValue)
+{
+    uint32_t entry = table->entries[((randomValue >> 16) * table->count) >> 16];
+
+    return ((randomValue & 0xFFFFU) < (entry >> 16)) ? (uint8_t)entry : (uint8_t)(entry >> 8);
+}
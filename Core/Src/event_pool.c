@@ -0,0 +1,107 @@
+/**
+ * @file event_pool.c
+ * @brief Implementation of the fixed-capacity event pool.
+ *
+ * Free records are kept on a LIFO stack of handles. Allocation and release are
+ * O(1) and run inside a short critical section, so they are safe from both
+ * tasks and ISRs (up to configMAX_SYSCALL_INTERRUPT_PRIORITY).
+ *
+ * @date October 15, 2026
+ * @author shayb
+ */
+
+#include "event_pool.h"
+#include "FreeRTOS.h"
+#include "task.h"
+
+// --- Static Variables ---
+static EmergencyEvent_t eventRecords[EVENT_POOL_SIZE]; // The event records themselves
+static EventHandle_t freeStack[EVENT_POOL_SIZE];       // Handles of the free records
+static volatile UBaseType_t freeCount = 0;             // Number of valid entries in freeStack
+
+// --- Private Functions ---
+
+/**
+ * @brief Pops a free handle. Caller holds the critical section.
+ */
+static inline EventHandle_t EventPool_PopLocked(void)
+{
+    if (freeCount == 0)
+    {
+        return EVENT_HANDLE_INVALID;
+    }
+    return freeStack[--freeCount];
+}
+
+/**
+ * @brief Pushes a handle back on the free stack. Caller holds the critical section.
+ */
+static inline void EventPool_PushLocked(EventHandle_t handle)
+{
+    configASSERT(handle < EVENT_POOL_SIZE);
+    configASSERT(freeCount < EVENT_POOL_SIZE); // Double release
+    freeStack[freeCount++] = handle;
+}
+
+// --- Public Functions ---
+
+void EventPool_Init(void)
+{
+    UBaseType_t i;
+
+    taskENTER_CRITICAL();
+    for (i = 0; i < EVENT_POOL_SIZE; ++i)
+    {
+        freeStack[i] = (EventHandle_t)(EVENT_POOL_SIZE - 1 - i); // Hand out low handles first
+    }
+    freeCount = EVENT_POOL_SIZE;
+    taskEXIT_CRITICAL();
+}
+
+EventHandle_t EventPool_Alloc(void)
+{
+    EventHandle_t handle;
+
+    taskENTER_CRITICAL();
+    handle = EventPool_PopLocked();
+    taskEXIT_CRITICAL();
+    return handle;
+}
+
+EventHandle_t EventPool_AllocFromISR(void)
+{
+    EventHandle_t handle;
+    UBaseType_t uxSavedInterruptStatus;
+
+    uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+    handle = EventPool_PopLocked();
+    taskEXIT_CRITICAL_FROM_ISR(uxSavedInterruptStatus);
+    return handle;
+}
+
+void EventPool_Release(EventHandle_t handle)
+{
+    taskENTER_CRITICAL();
+    EventPool_PushLocked(handle);
+    taskEXIT_CRITICAL();
+}
+
+void EventPool_ReleaseFromISR(EventHandle_t handle)
+{
+    UBaseType_t uxSavedInterruptStatus;
+
+    uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+    EventPool_PushLocked(handle);
+    taskEXIT_CRITICAL_FROM_ISR(uxSavedInterruptStatus);
+}
+
+EmergencyEvent_t *EventPool_Get(EventHandle_t handle)
+{
+    configASSERT(handle < EVENT_POOL_SIZE);
+    return &eventRecords[handle];
+}
+
+UBaseType_t EventPool_FreeCount(void)
+{
+    return freeCount;
+}
@@ -17,6 +17,7 @@
 #include "FreeRTOS.h"
 #include "task.h"
 #include "queue.h"
+#include "prio_queue.h"
 #include <stdio.h>
 
 /**
@@ -24,8 +25,9 @@
  *
  * This queue is used for communication between Fire Department tasks and other modules.
  */
-QueueHandle_t xFireDeptQueue = NULL;
+PrioQueueHandle_t xFireDeptQueue = NULL;
 
+#if UNIT_MODEL == UNIT_MODEL_TASK
 /**
  * @brief Task parameters for Fire Department tasks.
  *
@@ -43,6 +45,7 @@ static ResourceTaskParams_t fireDeptTaskParams[RESOURCES_FIRE_DEPT];
  * defined in the project configuration.
  */
 static char fireDeptTaskNames[RESOURCES_FIRE_DEPT][configMAX_TASK_NAME_LEN];
+#endif
 
 /**
  * @brief Initializes the Fire Department module.
@@ -54,10 +57,12 @@ static char fireDeptTaskNames[RESOURCES_FIRE_DEPT][configMAX_TASK_NAME_LEN];
  * @param numUnits The number of Fire Department units to initialize.
  * @return pdPASS if all tasks are created successfully, pdFAIL otherwise.
  */
-BaseType_t FireDept_Init(uint8_t numUnits)
+BaseType_t FireDept_Init(uint16_t numUnits)
 {
     BaseType_t xReturned = pdPASS;
+#if UNIT_MODEL == UNIT_MODEL_TASK
     uint8_t i;
+#endif
 
     printf("Initializing Fire Department with %d units...\r\n", numUnits);
     if (numUnits > RESOURCES_FIRE_DEPT)
@@ -72,10 +77,20 @@ BaseType_t FireDept_Init(uint8_t numUnits)
         return pdFAIL;
     }
 
+#if UNIT_MODEL == UNIT_MODEL_SCHEDULER
+    // One scheduler task simulates every unit of the department
+    if (ResourceUnit_CreateScheduler(DEPT_FIRE, xFireDeptQueue, numUnits, "FireDept") != pdPASS)
+    {
+        printf("Failed to create Fire Department scheduler!\r\n");
+        return pdFAIL;
+    }
+#else
     for (i = 0; i < numUnits; ++i)
     {
         // Prepare parameters for this specific task instance
         fireDeptTaskParams[i].xDepartmentQueue = xFireDeptQueue;
+        fireDeptTaskParams[i].departmentType = DEPT_FIRE;
+        fireDeptTaskParams[i].unitIndex = i;
 
         // Create a unique name for this task instance
         snprintf(fireDeptTaskNames[i], configMAX_TASK_NAME_LEN, "FireDept_%d", i + 1);
@@ -95,6 +110,7 @@ BaseType_t FireDept_Init(uint8_t numUnits)
             return pdFAIL; // Stop initialization on first failure
         }
     }
+#endif
     printf("Fire Department task creation complete.\r\n");
     return xReturned;
 }
\ No newline at end of file
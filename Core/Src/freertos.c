@@ -24,6 +24,7 @@
 
 /* Private includes ----------------------------------------------------------*/
 /* USER CODE BEGIN Includes */
+#include "timer_wheel.h"
 
 /* USER CODE END Includes */
 
@@ -44,6 +45,8 @@
 
 /* Private variables ---------------------------------------------------------*/
 /* USER CODE BEGIN Variables */
+/* Incremented by traceTASK_SWITCHED_IN() (see FreeRTOSConfig.h) */
+volatile uint32_t ulContextSwitchCount = 0;
 
 /* USER CODE END Variables */
 
@@ -52,6 +55,20 @@
 
 /* USER CODE END FunctionPrototypes */
 
+/* Hook prototypes */
+void vApplicationTickHook(void);
+
+/* USER CODE BEGIN 3 */
+void vApplicationTickHook(void)
+{
+  /* Advances the unit mission timers. A task woken here is switched in by the
+  tick itself (xYieldPending), so the flag is not needed. */
+  BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+  TimerWheel_TickFromISR(&xHigherPriorityTaskWoken);
+}
+/* USER CODE END 3 */
+
 /* Private application code --------------------------------------------------*/
 /* USER CODE BEGIN Application */
 
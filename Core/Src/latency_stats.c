@@ -0,0 +1,195 @@
+/**
+ * @file latency_stats.c
+ * @brief Implementation of the per-department latency histograms.
+ *
+ * @date October 15, 2026
+ * @author shayb
+ */
+
+#include "latency_stats.h"
+#include "time_base.h"
+#include "routing_table.h" // For Routing_DeptName
+#include "logging.h"
+#include "task.h"
+#include "timers.h" // For xTimerPendFunctionCallFromISR
+#include "main.h"   // For __CLZ (CMSIS)
+
+static LatencyHistogram_t histograms[DEPT_COUNT][LATENCY_INTERVAL_COUNT];
+static LatencyHistogram_t criticalHistograms[2][LATENCY_INTERVAL_COUNT]; // [pre-emption off/on]
+
+/**
+ * @brief Stage pair delimiting each interval.
+ */
+static const uint8_t intervalStages[LATENCY_INTERVAL_COUNT][2] = {
+    [LATENCY_DISPATCH] = {EVENT_STAGE_GENERATED, EVENT_STAGE_DISPATCHED},
+    [LATENCY_ROUTE] = {EVENT_STAGE_DISPATCHED, EVENT_STAGE_ENQUEUED},
+    [LATENCY_QUEUE] = {EVENT_STAGE_ENQUEUED, EVENT_STAGE_PICKED_UP},
+    [LATENCY_SERVICE] = {EVENT_STAGE_PICKED_UP, EVENT_STAGE_COMPLETED},
+    [LATENCY_END_TO_END] = {EVENT_STAGE_GENERATED, EVENT_STAGE_COMPLETED},
+    [LATENCY_RESPONSE] = {EVENT_STAGE_GENERATED, EVENT_STAGE_ON_SCENE},
+};
+
+static const char *const intervalNames[LATENCY_INTERVAL_COUNT] = {
+    [LATENCY_DISPATCH] = "dispatch",
+    [LATENCY_ROUTE] = "route",
+    [LATENCY_QUEUE] = "queue",
+    [LATENCY_SERVICE] = "service",
+    [LATENCY_END_TO_END] = "end-to-end",
+    [LATENCY_RESPONSE] = "response",
+};
+
+// --- Private Functions ---
+
+/**
+ * @brief Maps a latency to its log2 bucket: 0 -> 0, [2^(N-1), 2^N) -> N.
+ */
+static inline uint8_t LatencyStats_Bucket(uint32_t us)
+{
+    uint32_t bucket = 32U - __CLZ(us);
+    return (bucket < LATENCY_HIST_BUCKETS) ? (uint8_t)bucket : (LATENCY_HIST_BUCKETS - 1U);
+}
+
+/**
+ * @brief Adds one sample to a histogram (caller holds the critical section).
+ */
+static inline void LatencyStats_Add(LatencyHistogram_t *hist, uint32_t us)
+{
+    hist->buckets[LatencyStats_Bucket(us)]++;
+    hist->count++;
+    if (us > hist->maxUs)
+    {
+        hist->maxUs = us;
+    }
+}
+
+/**
+ * @brief Logs the summary of one histogram, if it has samples.
+ */
+static void LatencyStats_LogHistogram(const char *label, const char *interval, const LatencyHistogram_t *hist)
+{
+    if (hist->count == 0)
+    {
+        return;
+    }
+    LogInfo("%s %s: n=%lu p50<=%lu p90<=%lu p99<=%lu max=%lu\r\n", label, interval, hist->count,
+            LatencyStats_Percentile(hist, 50), LatencyStats_Percentile(hist, 90), LatencyStats_Percentile(hist, 99), hist->maxUs);
+}
+
+/**
+ * @brief Timer service task callback for LatencyStats_RequestDumpFromISR().
+ */
+static void LatencyStats_DumpPended(void *pvParameter1, uint32_t ulParameter2)
+{
+    (void)pvParameter1;
+    (void)ulParameter2;
+    LatencyStats_Dump();
+}
+
+// --- Public Functions ---
+
+void LatencyStats_Record(uint8_t department, const EmergencyEvent_t *event)
+{
+    uint32_t us[LATENCY_INTERVAL_COUNT];
+    uint8_t i;
+
+    configASSERT(department < DEPT_COUNT);
+
+    // Compute outside the critical section, only the counter updates need it
+    for (i = 0; i < LATENCY_INTERVAL_COUNT; ++i)
+    {
+        us[i] = TimeBase_ElapsedUs(event->stamps[intervalStages[i][0]], event->stamps[intervalStages[i][1]]);
+    }
+
+    taskENTER_CRITICAL();
+    for (i = 0; i < LATENCY_INTERVAL_COUNT; ++i)
+    {
+        if (i == LATENCY_ROUTE && event->requeues != 0)
+        {
+            continue; // Enqueued was restamped on the hand-back: the interval spans a unit's service
+        }
+        LatencyStats_Add(&histograms[department][i], us[i]);
+        if (event->severity == EVENT_SEVERITY_CRITICAL)
+        {
+            LatencyStats_Add(&criticalHistograms[event->preemption ? 1 : 0][i], us[i]);
+        }
+    }
+    taskEXIT_CRITICAL();
+}
+
+void LatencyStats_Get(uint8_t department, uint8_t interval, LatencyHistogram_t *hist)
+{
+    configASSERT(department < DEPT_COUNT && interval < LATENCY_INTERVAL_COUNT);
+
+    taskENTER_CRITICAL();
+    *hist = histograms[department][interval];
+    taskEXIT_CRITICAL();
+}
+
+void LatencyStats_GetCritical(uint8_t preemption, uint8_t interval, LatencyHistogram_t *hist)
+{
+    configASSERT(preemption < 2 && interval < LATENCY_INTERVAL_COUNT);
+
+    taskENTER_CRITICAL();
+    *hist = criticalHistograms[preemption][interval];
+    taskEXIT_CRITICAL();
+}
+
+uint32_t LatencyStats_Percentile(const LatencyHistogram_t *hist, uint8_t percent)
+{
+    uint32_t target, seen = 0;
+    uint8_t i;
+
+    if (hist->count == 0)
+    {
+        return 0;
+    }
+
+    target = (uint32_t)(((uint64_t)hist->count * percent + 99U) / 100U); // Rank of the sample, rounded up
+    for (i = 0; i < LATENCY_HIST_BUCKETS; ++i)
+    {
+        seen += hist->buckets[i];
+        if (seen >= target)
+        {
+            if (i == LATENCY_HIST_BUCKETS - 1U)
+            {
+                return hist->maxUs; // Overflow bucket has no upper bound
+            }
+            return (i == 0) ? 0 : (1UL << i) - 1U;
+        }
+    }
+    return hist->maxUs;
+}
+
+void LatencyStats_Dump(void)
+{
+    LatencyHistogram_t hist;
+    uint8_t dept, i;
+
+    LogInfo("--- Latency (simulated us, dilation x%lu, log2 buckets: p = bucket upper bound) ---\r\n", TimeBase_GetDilation());
+    for (dept = 0; dept < DEPT_COUNT; ++dept)
+    {
+        for (i = 0; i < LATENCY_INTERVAL_COUNT; ++i)
+        {
+            LatencyStats_Get(dept, i, &hist);
+            LatencyStats_LogHistogram(Routing_DeptName(dept), intervalNames[i], &hist);
+        }
+    }
+
+    // Critical calls with and without pre-emption, for the intervals it changes
+    for (i = 0; i < 2; ++i)
+    {
+        LatencyStats_GetCritical(i, LATENCY_RESPONSE, &hist);
+        LatencyStats_LogHistogram(i ? "Critical (pre-emption on)" : "Critical (pre-emption off)", intervalNames[LATENCY_RESPONSE], &hist);
+        LatencyStats_GetCritical(i, LATENCY_END_TO_END, &hist);
+        LatencyStats_LogHistogram(i ? "Critical (pre-emption on)" : "Critical (pre-emption off)", intervalNames[LATENCY_END_TO_END], &hist);
+    }
+}
+
+void LatencyStats_RequestDumpFromISR(BaseType_t *pxHigherPriorityTaskWoken)
+{
+    if (xTaskGetSchedulerState() == taskSCHEDULER_NOT_STARTED)
+    {
+        return; // Timer command queue does not exist yet
+    }
+    (void)xTimerPendFunctionCallFromISR(LatencyStats_DumpPended, NULL, 0, pxHigherPriorityTaskWoken);
+}
@@ -23,12 +23,17 @@
 #include "task.h"
 #include "queue.h"
 #include "semphr.h" // Include if using mutex for logging
+#include "prio_queue.h"
 
 // Project-specific includes
 #include "project_config.h"
 #include "logging.h"
 //#include "event_generator.h"
 #include "dispatcher.h"
+#include "time_base.h"
+#include "rng_service.h"
+#include "latency_stats.h"
+#include "trace.h"
 //#include "ambulance.h"
 //#include "police.h"
 //#include "fire_dept.h"
@@ -65,10 +70,9 @@ UART_HandleTypeDef huart3;
 //  .priority = (osPriority_t) osPriorityNormal,
 //};
 /* USER CODE BEGIN PV */
-extern QueueHandle_t xDispatcherQueue;
-extern QueueHandle_t xAmbulanceQueue;
-extern QueueHandle_t xPoliceQueue;
-extern QueueHandle_t xFireDeptQueue;
+extern PrioQueueHandle_t xAmbulanceQueue;
+extern PrioQueueHandle_t xPoliceQueue;
+extern PrioQueueHandle_t xFireDeptQueue;
 
 // Mutexes
 SemaphoreHandle_t xUartMutex = NULL; // If using mutex-protected logging function
@@ -131,6 +135,9 @@ int main(void)
   printf("System Clock Configured.\r\n");
   printf("Peripherals Initialized.\r\n");
 
+  TimeBase_Init(); // 64-bit microsecond system clock (DWT cycle counter)
+  RngService_Init(); // Interrupt-driven random word ring (needs the DWT for its fallback seed)
+
   /* USER CODE END 2 */
 
   /* Init scheduler */
@@ -378,6 +385,10 @@ static void MX_GPIO_Init(void)
   GPIO_InitStruct.Speed = GPIO_SPEED_FREQ_LOW;
   HAL_GPIO_Init(GPIOB, &GPIO_InitStruct);
 
+  /* EXTI interrupt init*/
+  HAL_NVIC_SetPriority(EXTI15_10_IRQn, 5, 0);
+  HAL_NVIC_EnableIRQ(EXTI15_10_IRQn);
+
   /* USER CODE BEGIN MX_GPIO_Init_2 */
 
   /* USER CODE END MX_GPIO_Init_2 */
@@ -391,6 +402,37 @@ int __io_putchar(int ch)
 	return ch;
 }
 
+/**
+  * @brief  EXTI line detection callback.
+  *
+  * A USER_Btn press dumps the latency histograms and the recorded trace. Edges
+  * within USER_BTN_LOCKOUT_MS of the last accepted one are contact bounce and
+  * are ignored.
+  * @param  GPIO_Pin Pin that triggered the interrupt.
+  * @retval None
+  */
+void HAL_GPIO_EXTI_Callback(uint16_t GPIO_Pin)
+{
+  static TickType_t lastPressTick = 0;
+  static BaseType_t xPressSeen = pdFALSE;
+  BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+  TickType_t now;
+
+  if (GPIO_Pin == USER_Btn_Pin)
+  {
+    now = xTaskGetTickCountFromISR();
+    if (xPressSeen && (now - lastPressTick) < TimeBase_MsToTicks(USER_BTN_LOCKOUT_MS))
+    {
+      return; // Bounce of the previous press
+    }
+    lastPressTick = now;
+    xPressSeen = pdTRUE;
+    LatencyStats_RequestDumpFromISR(&xHigherPriorityTaskWoken);
+    TraceRecorder_RequestDumpFromISR(&xHigherPriorityTaskWoken);
+  }
+  portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+}
+
 // Static variables to maintain state between interrupts
 // Initialize ticksUntilNextEvent to generate the first event relatively quickly
 //static uint32_t ticksUntilNextEvent = MIN_EVENT_DELAY_TICKS; // Start with min delay
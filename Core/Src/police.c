@@ -18,14 +18,17 @@
 #include "FreeRTOS.h"
 #include "task.h"
 #include "queue.h"
+#include "prio_queue.h"
 #include <stdio.h>
 
-QueueHandle_t xPoliceQueue = NULL;
+PrioQueueHandle_t xPoliceQueue = NULL;
 
+#if UNIT_MODEL == UNIT_MODEL_TASK
 // Task parameter storage for police tasks (file scope)
 // Size needs to accommodate max possible units defined in config
 static ResourceTaskParams_t policeTaskParams[RESOURCES_POLICE];
 static char policeTaskNames[RESOURCES_POLICE][configMAX_TASK_NAME_LEN];
+#endif
 
 /**
  * @brief Initialization function for the Police Department.
@@ -39,10 +42,12 @@ static char policeTaskNames[RESOURCES_POLICE][configMAX_TASK_NAME_LEN];
  *
  * @return pdPASS if all tasks are created successfully, otherwise pdFAIL.
  */
-BaseType_t Police_Init(uint8_t numUnits)
+BaseType_t Police_Init(uint16_t numUnits)
 {
     BaseType_t xReturned = pdPASS;
+#if UNIT_MODEL == UNIT_MODEL_TASK
     uint8_t i;
+#endif
 
     printf("Initializing Police Department with %d units...\r\n", numUnits);
 
@@ -58,10 +63,20 @@ BaseType_t Police_Init(uint8_t numUnits)
         return pdFAIL; // Cannot proceed
     }
 
+#if UNIT_MODEL == UNIT_MODEL_SCHEDULER
+    // One scheduler task simulates every unit of the department
+    if (ResourceUnit_CreateScheduler(DEPT_POLICE, xPoliceQueue, numUnits, "Police") != pdPASS)
+    {
+        printf("Failed to create Police scheduler!\r\n");
+        return pdFAIL;
+    }
+#else
     for (i = 0; i < numUnits; ++i)
     {
         // Prepare parameters for this specific task instance
         policeTaskParams[i].xDepartmentQueue = xPoliceQueue;
+        policeTaskParams[i].departmentType = DEPT_POLICE;
+        policeTaskParams[i].unitIndex = i;
 
         // Create a unique name for this task instance
         snprintf(policeTaskNames[i], configMAX_TASK_NAME_LEN, "Police_%d", i + 1);
@@ -81,6 +96,7 @@ BaseType_t Police_Init(uint8_t numUnits)
             return pdFAIL; // Stop initialization on first failure
         }
     }
+#endif
     printf("Police task creation complete.\r\n");
     return xReturned; // pdPASS if all tasks created ok (or pdFAIL if clamped/error)
 }
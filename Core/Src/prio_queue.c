@@ -0,0 +1,208 @@
+/**
+ * @file prio_queue.c
+ * @brief Implementation of the bounded multi-level priority queue.
+ *
+ * Every queue owns a fixed pool of item slots. Each priority level is a singly
+ * linked FIFO threaded through those slots, and unused slots form a free list.
+ * Bit N of the level bitmap is set while level N is non-empty, so the highest
+ * pending level is found with a single CLZ instruction.
+ *
+ * Blocking is delegated to two counting semaphores (items and spaces), which
+ * gives the same blocking semantics as xQueueSend / xQueueReceive. The slot
+ * lists themselves are protected by short critical sections.
+ *
+ * @date October 15, 2026
+ * @author shayb
+ */
+
+#include "prio_queue.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "semphr.h"
+#include "main.h" // For __CLZ (CMSIS)
+#include <string.h>
+
+#define PRIO_QUEUE_END 0xFFU // Link value marking the end of a list
+
+struct PrioQueue
+{
+    uint8_t *pucItems;                      // Item storage: uxLength * uxItemSize bytes
+    uint8_t *pucNext;                       // Per-slot link to the next slot in the same list
+    uint8_t ucHead[PRIO_QUEUE_MAX_LEVELS];  // Oldest slot of each level
+    uint8_t ucTail[PRIO_QUEUE_MAX_LEVELS];  // Newest slot of each level
+    uint8_t ucFreeHead;                     // First unused slot
+    uint32_t ulLevelBitmap;                 // Bit N set while level N is non-empty
+    volatile UBaseType_t uxItemCount;       // Items currently linked (readable without locking)
+    UBaseType_t uxLength;                   // Capacity in items
+    UBaseType_t uxItemSize;                 // Size of one item in bytes
+    SemaphoreHandle_t xItemsAvailable;      // Counts stored items (consumers block here)
+    SemaphoreHandle_t xSpacesAvailable;     // Counts free slots (producers block here)
+};
+
+// --- Private Functions ---
+
+/**
+ * @brief Links a copy of the item at the tail of its level. Caller holds the critical section.
+ */
+static void PrioQueue_InsertLocked(PrioQueue_t *pxQueue, const void *pvItem, UBaseType_t uxLevel)
+{
+    uint8_t ucSlot = pxQueue->ucFreeHead;
+
+    configASSERT(ucSlot != PRIO_QUEUE_END); // Guaranteed by the spaces semaphore
+    pxQueue->ucFreeHead = pxQueue->pucNext[ucSlot];
+
+    memcpy(&pxQueue->pucItems[ucSlot * pxQueue->uxItemSize], pvItem, pxQueue->uxItemSize);
+    pxQueue->pucNext[ucSlot] = PRIO_QUEUE_END;
+
+    if (pxQueue->ulLevelBitmap & (1UL << uxLevel))
+    {
+        pxQueue->pucNext[pxQueue->ucTail[uxLevel]] = ucSlot;
+    }
+    else
+    {
+        pxQueue->ucHead[uxLevel] = ucSlot;
+        pxQueue->ulLevelBitmap |= (1UL << uxLevel);
+    }
+    pxQueue->ucTail[uxLevel] = ucSlot;
+    pxQueue->uxItemCount++;
+}
+
+/**
+ * @brief Unlinks the oldest item of the highest level. Caller holds the critical section.
+ */
+static void PrioQueue_PopLocked(PrioQueue_t *pxQueue, void *pvBuffer)
+{
+    configASSERT(pxQueue->ulLevelBitmap != 0); // Guaranteed by the items semaphore
+
+    UBaseType_t uxLevel = 31U - __CLZ(pxQueue->ulLevelBitmap);
+    uint8_t ucSlot = pxQueue->ucHead[uxLevel];
+
+    memcpy(pvBuffer, &pxQueue->pucItems[ucSlot * pxQueue->uxItemSize], pxQueue->uxItemSize);
+
+    pxQueue->ucHead[uxLevel] = pxQueue->pucNext[ucSlot];
+    if (pxQueue->ucHead[uxLevel] == PRIO_QUEUE_END)
+    {
+        pxQueue->ulLevelBitmap &= ~(1UL << uxLevel);
+    }
+
+    // Return the slot to the free list
+    pxQueue->pucNext[ucSlot] = pxQueue->ucFreeHead;
+    pxQueue->ucFreeHead = ucSlot;
+    pxQueue->uxItemCount--;
+}
+
+/**
+ * @brief Clamps a requested level to the supported range.
+ */
+static inline UBaseType_t PrioQueue_ClampLevel(UBaseType_t uxLevel)
+{
+    return (uxLevel < PRIO_QUEUE_MAX_LEVELS) ? uxLevel : (PRIO_QUEUE_MAX_LEVELS - 1U);
+}
+
+// --- Public Functions ---
+
+PrioQueueHandle_t PrioQueue_Create(UBaseType_t uxLength, UBaseType_t uxItemSize)
+{
+    PrioQueue_t *pxQueue;
+    UBaseType_t i;
+
+    if (uxLength == 0 || uxLength > PRIO_QUEUE_MAX_LENGTH || uxItemSize == 0)
+    {
+        return NULL;
+    }
+
+    // Single allocation: control block, item storage, then the link array
+    pxQueue = pvPortMalloc(sizeof(PrioQueue_t) + (uxLength * uxItemSize) + uxLength);
+    if (pxQueue == NULL)
+    {
+        return NULL;
+    }
+
+    pxQueue->pucItems = (uint8_t *)(pxQueue + 1);
+    pxQueue->pucNext = pxQueue->pucItems + (uxLength * uxItemSize);
+    pxQueue->uxLength = uxLength;
+    pxQueue->uxItemSize = uxItemSize;
+    pxQueue->ulLevelBitmap = 0;
+    pxQueue->uxItemCount = 0;
+
+    // Chain every slot into the free list
+    for (i = 0; i < uxLength; ++i)
+    {
+        pxQueue->pucNext[i] = (i + 1 < uxLength) ? (uint8_t)(i + 1) : PRIO_QUEUE_END;
+    }
+    pxQueue->ucFreeHead = 0;
+
+    for (i = 0; i < PRIO_QUEUE_MAX_LEVELS; ++i)
+    {
+        pxQueue->ucHead[i] = PRIO_QUEUE_END;
+        pxQueue->ucTail[i] = PRIO_QUEUE_END;
+    }
+
+    pxQueue->xItemsAvailable = xSemaphoreCreateCounting(uxLength, 0);
+    pxQueue->xSpacesAvailable = xSemaphoreCreateCounting(uxLength, uxLength);
+    if (pxQueue->xItemsAvailable == NULL || pxQueue->xSpacesAvailable == NULL)
+    {
+        if (pxQueue->xItemsAvailable != NULL)
+        {
+            vSemaphoreDelete(pxQueue->xItemsAvailable);
+        }
+        if (pxQueue->xSpacesAvailable != NULL)
+        {
+            vSemaphoreDelete(pxQueue->xSpacesAvailable);
+        }
+        vPortFree(pxQueue);
+        return NULL;
+    }
+
+    return pxQueue;
+}
+
+BaseType_t PrioQueue_Send(PrioQueueHandle_t xQueue, const void *pvItem, UBaseType_t uxLevel, TickType_t xTicksToWait)
+{
+    configASSERT(xQueue != NULL);
+
+    // Reserve a slot first (this is where the caller may block)
+    if (xSemaphoreTake(xQueue->xSpacesAvailable, xTicksToWait) != pdTRUE)
+    {
+        return errQUEUE_FULL;
+    }
+
+    taskENTER_CRITICAL();
+    PrioQueue_InsertLocked(xQueue, pvItem, PrioQueue_ClampLevel(uxLevel));
+    taskEXIT_CRITICAL();
+
+    // Publish the item to consumers
+    xSemaphoreGive(xQueue->xItemsAvailable);
+    return pdPASS;
+}
+
+BaseType_t PrioQueue_Receive(PrioQueueHandle_t xQueue, void *pvBuffer, TickType_t xTicksToWait)
+{
+    configASSERT(xQueue != NULL);
+
+    if (xSemaphoreTake(xQueue->xItemsAvailable, xTicksToWait) != pdTRUE)
+    {
+        return errQUEUE_EMPTY;
+    }
+
+    taskENTER_CRITICAL();
+    PrioQueue_PopLocked(xQueue, pvBuffer);
+    taskEXIT_CRITICAL();
+
+    // Release the slot to producers
+    xSemaphoreGive(xQueue->xSpacesAvailable);
+    return pdPASS;
+}
+
+UBaseType_t PrioQueue_MessagesWaiting(PrioQueueHandle_t xQueue)
+{
+    configASSERT(xQueue != NULL);
+    // A single aligned word read is atomic on Cortex-M, no critical section needed
+    return xQueue->uxItemCount;
+}
+
+UBaseType_t PrioQueue_SpacesAvailable(PrioQueueHandle_t xQueue)
+{
+    configASSERT(xQueue != NULL);
+    return xQueue->uxLength - xQueue->uxItemCount;
+}
@@ -8,6 +8,19 @@
  * and simulates task execution time. It also includes utility functions such as
  * GetRandomTaskDurationTicks for generating random task durations.
  *
+ * With UNIT_MODEL_SCHEDULER the same unit behaviour is provided by one scheduler
+ * task per department, which keeps its units as records.
+ *
+ * In both models a unit runs through the lifecycle phases of unit_lifecycle.h,
+ * timed on the timing wheel (timer_wheel.h) rather than in the kernel's
+ * delayed list, and publishes every transition in its department's state array
+ * and its utilization accounting (utilization.h).
+ *
+ * A unit that is turning out, en route or on scene can be pre-empted for a more
+ * severe call (PREEMPTION_MODE): its phase timer is cancelled, the call goes
+ * back to the department queue with the on-scene work done so far, and the unit
+ * takes the most severe queued call. No task is ever deleted or restarted.
+ *
  * @date April 23, 2025
  * @author shayb
  */
@@ -29,16 +42,560 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include "resource_task.h"
+#include "event_pool.h"
+#include "dispatcher.h"
+#include "time_base.h"
+#include "service_time.h"
+#include "latency_stats.h"
+#include "rng_service.h"
+#include "spsc_ring.h"
+#include "timer_wheel.h"
+#include "unit_lifecycle.h"
+#include "utilization.h"
+
+#if UNIT_MODEL == UNIT_MODEL_TASK
+#if (RESOURCES_AMBULANCE > MAX_UNITS_PER_DEPT) || (RESOURCES_POLICE > MAX_UNITS_PER_DEPT) || (RESOURCES_FIRE_DEPT > MAX_UNITS_PER_DEPT)
+#error "A department has more units than MAX_UNITS_PER_DEPT"
+#endif
+#elif (RESOURCES_AMBULANCE > MAX_SCHEDULED_UNITS_PER_DEPT) || (RESOURCES_POLICE > MAX_SCHEDULED_UNITS_PER_DEPT) || (RESOURCES_FIRE_DEPT > MAX_SCHEDULED_UNITS_PER_DEPT)
+#error "A department has more units than MAX_SCHEDULED_UNITS_PER_DEPT"
+#endif
+
+// --- Department Unit Tables ---
+
+/**
+ * @brief Idle tracking for one department.
+ *
+ * A unit is marked idle only while it waits for a direct hand-off and its
+ * department queue is empty; the dispatcher unmarks it when it claims the unit.
+ * Both sides update the idle state with the scheduler suspended, which makes
+ * "queue empty -> mark idle" (unit) and "no idle unit -> enqueue" (dispatcher)
+ * mutually exclusive, so no event can be stranded in the queue while a unit sleeps.
+ *
+ * A unit told to hand back its call for a pre-emption is flagged (preemptMask,
+ * or preemptPending in its record) until it has done so, or until its call
+ * ended first; requeuePending queue slots are kept free meanwhile.
+ */
+typedef struct
+{
+#if UNIT_MODEL == UNIT_MODEL_SCHEDULER
+    volatile uint16_t idleCount;                // Idle units not yet claimed by the dispatcher
+    volatile uint32_t *unitStates;              // State word of each unit (unit_lifecycle.h)
+    UnitUtil_t *unitUtil;                       // Time accounting of each unit
+#else
+    volatile uint32_t idleMask;                 // Bit N set while unit N is idle
+    volatile uint32_t preemptMask;              // Bit N set while unit N is told to hand back its call
+    TaskHandle_t unitTasks[MAX_UNITS_PER_DEPT]; // Task of each unit, for direct notification
+    volatile EventHandle_t unitCalls[MAX_UNITS_PER_DEPT]; // Call each unit is serving (pre-emption candidates)
+    volatile uint32_t unitStates[MAX_UNITS_PER_DEPT]; // State word of each unit (unit_lifecycle.h)
+    UnitUtil_t unitUtil[MAX_UNITS_PER_DEPT];    // Time accounting of each unit
+#endif
+    volatile uint32_t meanServiceScaled;        // Running mean service time << SERVICE_TIME_EWMA_SHIFT
+    volatile uint16_t numUnits;                 // Units registered so far
+    volatile uint16_t requeuePending;           // Queue slots kept for calls being handed back
+} DeptUnits_t;
+
+static DeptUnits_t deptUnits[DEPT_COUNT];
 
-// --- Function Prototypes ---
+#if UNIT_MODEL == UNIT_MODEL_TASK
+// Task notification bits of a unit task
+#define UNIT_NOTIFY_HANDLE_MASK 0xFFUL // Event handle of a hand-off
+#define UNIT_NOTIFY_HANDOFF (1UL << 8) // The dispatcher handed over a call
+#define UNIT_NOTIFY_TIMER (1UL << 9)   // The current phase is over
+#define UNIT_NOTIFY_PREEMPT (1UL << 10) // Hand back the call (if preemptMask still says so)
+#endif
 
-// --- Task Parameter Structure ---
+static volatile BaseType_t preemptionEnabled = (PREEMPTION_MODE != PREEMPTION_OFF) ? pdTRUE : pdFALSE;
+
+#if UNIT_MODEL == UNIT_MODEL_SCHEDULER
+#define UNIT_INDEX_NONE 0xFFFFU // End of a unit list
+#define VICTIM_PHASE_COUNT (UNIT_PHASE_ON_SCENE - UNIT_PHASE_DISPATCHED + 1) // Pre-emptible phases
+#define VICTIM_BUCKET_COUNT (NUM_SEVERITY_LEVELS * VICTIM_PHASE_COUNT)
+#define VICTIM_BUCKET_NONE 0xFFU // Not a pre-emption candidate
+
+_Static_assert(MAX_SCHEDULED_UNITS_PER_DEPT < UNIT_INDEX_NONE, "Unit indices must fit below UNIT_INDEX_NONE");
+
+/**
+ * @brief State of one simulated unit (scheduler mode).
+ *
+ * timerFired is set by the wheel and cleared when the expiry is handled or the
+ * phase is cancelled, so an expiry that was already queued when a returning
+ * unit got re-tasked is recognised as stale and ignored. The dispatcher sets
+ * preemptPending and takes the unit out of the pre-emption index; everything
+ * else belongs to the scheduler task.
+ *
+ * 48 bytes on the Cortex-M7; with its accounting (48), state word (4) and
+ * idle-stack slot (2) a unit costs 102 bytes.
+ */
+typedef struct UnitRecord
+{
+    TimerWheelTimer_t phaseTimer;   // End of the current phase (keep first, see ResourceUnit_PhaseDueFromISR)
+    struct UnitRecord *expiredNext; // Link in the department's expired list
+    UnitMission_t mission;          // Phase lengths of the current call
+    volatile EventHandle_t handle;  // Call being served
+    uint8_t phase;                  // UnitPhase_t
+    volatile uint8_t expiredQueued; // On the expired list
+    volatile uint8_t timerFired;    // phaseTimer fired and was neither handled nor cancelled
+    volatile uint8_t preemptPending; // Told to hand back its call (queued on the expired list)
+    uint8_t victimBucket;           // Bucket in the pre-emption index, VICTIM_BUCKET_NONE if not a candidate
+    uint16_t victimNext;            // Links in that bucket (unit indices)
+    uint16_t victimPrev;
+} UnitRecord_t;
+
+/**
+ * @brief All units of one department, served by a single task.
+ *
+ * Only the scheduler task touches the records and the idle stack. The
+ * dispatcher claims an idle unit by decrementing idleCount and passes the event
+ * over startRing; the scheduler then binds it to a unit from the idle stack, so
+ * the claim stays O(1) however many units the department has. Units whose
+ * phase is over are queued on the expired list by the timing wheel (tick
+ * interrupt), and units told to hand back their call by the dispatcher.
+ * Returning units are on the idle stack: they can be re-tasked.
+ *
+ * At most EVENT_POOL_SIZE units can be busy (each holds a pooled event), which
+ * bounds the ring independently of the unit count.
+ *
+ * Units that can be pre-empted are filed in victimHeads, one list per call
+ * severity and phase, so the dispatcher finds a victim without walking the
+ * units. The scheduler task files a unit on every phase change inside a
+ * critical section; the dispatcher reads the lists and unfiles the unit it
+ * pre-empts with the scheduler suspended.
+ */
+typedef struct
+{
+    PrioQueueHandle_t xQueue; // Shared department queue
+    const char *name;         // Department name, for logging
+    UnitRecord_t *records;    // One per unit
+    uint16_t *idleStack;      // Units not serving a call
+    uint16_t idleTop;         // Entries in idleStack
+    UnitRecord_t *expiredHead; // Units whose phase is over, linked by the wheel (FIFO)
+    UnitRecord_t *expiredTail;
+    SpscRing_t startRing;     // Calls handed to idle units, dispatcher -> scheduler
+    uint16_t victimHeads[VICTIM_BUCKET_COUNT]; // Pre-emption index: candidates by call severity, then phase
+    TaskHandle_t task;
+    uint8_t department;
+} DeptScheduler_t;
+
+static DeptScheduler_t deptSchedulers[DEPT_COUNT];
+#endif
+
+/**
+ * @brief Folds a drawn service time into the department's running mean.
+ *
+ * Exponentially weighted: mean += (sample - mean) / 2^SERVICE_TIME_EWMA_SHIFT,
+ * kept scaled by 2^SERVICE_TIME_EWMA_SHIFT to avoid losing precision.
+ */
+static void ResourceUnit_RecordServiceTime(DeptUnits_t *units, uint32_t serviceTicks)
+{
+    taskENTER_CRITICAL();
+    if (units->meanServiceScaled == 0)
+    {
+        units->meanServiceScaled = serviceTicks << SERVICE_TIME_EWMA_SHIFT; // First sample
+    }
+    else
+    {
+        units->meanServiceScaled = units->meanServiceScaled - (units->meanServiceScaled >> SERVICE_TIME_EWMA_SHIFT) + serviceTicks;
+    }
+    taskEXIT_CRITICAL();
+}
+
+/**
+ * @brief Moves a unit to a new phase: publishes its state word and accounts the time.
+ */
+static void ResourceUnit_SetPhase(DeptUnits_t *units, uint16_t unit, UnitPhase_t phase, TickType_t clearTick)
+{
+    units->unitStates[unit] = UnitState_Pack(phase, clearTick);
+    Utilization_Transition(&units->unitUtil[unit], phase);
+}
+
+#if UNIT_MODEL == UNIT_MODEL_SCHEDULER
+/**
+ * @brief Appends a unit to its scheduler's expired list (caller holds the critical section).
+ */
+static void ResourceUnit_QueueExpiredLocked(DeptScheduler_t *sched, UnitRecord_t *record)
+{
+    if (!record->expiredQueued)
+    {
+        record->expiredQueued = 1;
+        record->expiredNext = NULL;
+        if (sched->expiredTail != NULL)
+        {
+            sched->expiredTail->expiredNext = record;
+        }
+        else
+        {
+            sched->expiredHead = record;
+        }
+        sched->expiredTail = record;
+    }
+}
+#endif
+
+// --- Pre-emption ---
+
+#if UNIT_MODEL == UNIT_MODEL_SCHEDULER
+/**
+ * @brief Takes a unit out of the pre-emption index, if it is filed.
+ *
+ * The caller holds the critical section or has the scheduler suspended.
+ */
+static void ResourceUnit_UnindexVictimLocked(DeptScheduler_t *sched, UnitRecord_t *record)
+{
+    if (record->victimBucket == VICTIM_BUCKET_NONE)
+    {
+        return;
+    }
+    if (record->victimPrev != UNIT_INDEX_NONE)
+    {
+        sched->records[record->victimPrev].victimNext = record->victimNext;
+    }
+    else
+    {
+        sched->victimHeads[record->victimBucket] = record->victimNext;
+    }
+    if (record->victimNext != UNIT_INDEX_NONE)
+    {
+        sched->records[record->victimNext].victimPrev = record->victimPrev;
+    }
+    record->victimBucket = VICTIM_BUCKET_NONE;
+}
+
+/**
+ * @brief Re-files a unit in the pre-emption index after a phase change, O(1).
+ *
+ * Candidates serve a call, are turning out, en route or on scene, and have not
+ * been told to hand back their call yet. Scheduler task only.
+ */
+static void ResourceUnit_IndexVictim(DeptScheduler_t *sched, uint16_t unit)
+{
+    UnitRecord_t *record = &sched->records[unit];
+    const UnitPhase_t phase = (UnitPhase_t)record->phase;
+    uint8_t bucket;
+
+    taskENTER_CRITICAL();
+    ResourceUnit_UnindexVictimLocked(sched, record);
+    if (UnitLifecycle_IsPreemptible(phase) && record->handle != EVENT_HANDLE_INVALID && !record->preemptPending)
+    {
+        bucket = (uint8_t)((EventPool_Get(record->handle)->severity * VICTIM_PHASE_COUNT) + (phase - UNIT_PHASE_DISPATCHED));
+        record->victimBucket = bucket;
+        record->victimPrev = UNIT_INDEX_NONE;
+        record->victimNext = sched->victimHeads[bucket];
+        if (record->victimNext != UNIT_INDEX_NONE)
+        {
+            sched->records[record->victimNext].victimPrev = unit;
+        }
+        sched->victimHeads[bucket] = unit;
+    }
+    taskEXIT_CRITICAL();
+}
+
+/**
+ * @brief Picks the unit to interrupt for a call of @p severity, O(severity levels).
+ *
+ * The least severe call loses its unit; on a tie, a unit in the earliest phase,
+ * which throws away the least work. Buckets are ordered that way, so the first
+ * non-empty one below @p severity holds the victim. Called with the scheduler
+ * suspended.
+ *
+ * @return Unit index, or -1 if there is no candidate.
+ */
+static int32_t ResourceUnit_FindVictim(uint8_t department, uint8_t severity)
+{
+    const DeptScheduler_t *sched = &deptSchedulers[department];
+    uint32_t bucket;
+
+    for (bucket = 0; bucket < (uint32_t)severity * VICTIM_PHASE_COUNT; ++bucket)
+    {
+        if (sched->victimHeads[bucket] != UNIT_INDEX_NONE)
+        {
+            return (int32_t)sched->victimHeads[bucket];
+        }
+    }
+    return -1;
+}
+#else
+/**
+ * @brief Picks the unit to interrupt for a call of @p severity, O(units).
+ *
+ * Candidates serve a less severe call and are still turning out, en route or on
+ * scene. The least severe call loses its unit; on a tie, the unit in the
+ * earliest phase, which throws away the least work. Called with the scheduler
+ * suspended; the walk is bounded by MAX_UNITS_PER_DEPT.
+ *
+ * @return Unit index, or -1 if there is no candidate.
+ */
+static int32_t ResourceUnit_FindVictim(uint8_t department, uint8_t severity)
+{
+    const DeptUnits_t *units = &deptUnits[department];
+    uint32_t bestRank = UINT32_MAX;
+    int32_t victim = -1;
+    uint16_t i;
+
+    for (i = 0; i < units->numUnits; ++i)
+    {
+        const UnitPhase_t phase = UnitState_Phase(units->unitStates[i]);
+        const EventHandle_t handle = units->unitCalls[i];
+        uint32_t rank;
+
+        if (!UnitLifecycle_IsPreemptible(phase) || handle == EVENT_HANDLE_INVALID || (units->preemptMask & (1UL << i)) != 0)
+        {
+            continue;
+        }
+        rank = ((uint32_t)EventPool_Get(handle)->severity << 8) | (uint32_t)phase;
+        if (EventPool_Get(handle)->severity < severity && rank < bestRank)
+        {
+            bestRank = rank;
+            victim = (int32_t)i;
+        }
+    }
+    return victim;
+}
+#endif
+
+/**
+ * @brief Tells a unit to hand back its call and take the most severe queued one.
+ *
+ * Called with the scheduler suspended.
+ */
+static void ResourceUnit_SignalPreempt(uint8_t department, uint16_t unit)
+{
+#if UNIT_MODEL == UNIT_MODEL_SCHEDULER
+    DeptScheduler_t *sched = &deptSchedulers[department];
+
+    sched->records[unit].preemptPending = 1;
+    taskENTER_CRITICAL();
+    ResourceUnit_UnindexVictimLocked(sched, &sched->records[unit]);
+    ResourceUnit_QueueExpiredLocked(sched, &sched->records[unit]); // Handled along with the expired phases
+    taskEXIT_CRITICAL();
+    xTaskNotifyGive(sched->task);
+#else
+    deptUnits[department].preemptMask |= 1UL << unit;
+    (void)xTaskNotify(deptUnits[department].unitTasks[unit], UNIT_NOTIFY_PREEMPT, eSetBits);
+#endif
+}
+
+/**
+ * @brief Puts an interrupted call back in its department queue.
+ *
+ * On-scene work done so far is added to the event, so the next unit only does
+ * what is left. Called with the scheduler suspended; uses the queue slot the
+ * dispatcher kept free for it.
+ *
+ * @param phase Phase the unit was interrupted in.
+ */
+static void ResourceUnit_RequeueLocked(DeptUnits_t *units, PrioQueueHandle_t xQueue, EventHandle_t handle, UnitPhase_t phase)
+{
+    EmergencyEvent_t *event = EventPool_Get(handle);
+    BaseType_t xSent;
+
+    if (phase == UNIT_PHASE_ON_SCENE)
+    {
+        uint32_t doneUs = event->sceneDoneUs + TimeBase_ElapsedUs(event->stamps[EVENT_STAGE_ON_SCENE], TimeBase_SimNowUs());
+        event->sceneDoneUs = (doneUs < event->sceneUs) ? doneUs : event->sceneUs;
+    }
+    event->stamps[EVENT_STAGE_ENQUEUED] = TimeBase_SimNowUs(); // Queue latency is the wait after this hand-back
+    event->requeues++;
+    xSent = PrioQueue_Send(xQueue, &handle, event->severity, 0);
+    configASSERT(xSent == pdPASS); // The slot was kept free
+    (void)xSent;
+    units->requeuePending--;
+}
+
+// --- Public Functions ---
+
+HandOffResult_t ResourceUnit_HandOff(uint8_t department, PrioQueueHandle_t xQueue, EventHandle_t handle, uint8_t severity)
+{
+    DeptUnits_t *units = &deptUnits[department];
+    EmergencyEvent_t *event = EventPool_Get(handle);
+    HandOffResult_t result;
+    int32_t victim;
+
+    configASSERT(department < DEPT_COUNT);
+
+    event->stamps[EVENT_STAGE_ENQUEUED] = TimeBase_SimNowUs(); // Overwritten if rejected and retried
+    event->preemption = (uint8_t)preemptionEnabled;
+
+    vTaskSuspendAll();
+#if UNIT_MODEL == UNIT_MODEL_SCHEDULER
+    if (units->idleCount != 0)
+    {
+        // Claim any idle unit; the scheduler task binds the event to one
+        DeptScheduler_t *sched = &deptSchedulers[department];
+        units->idleCount--;
+        (void)SpscRing_Push(&sched->startRing, handle, NULL); // Never full: sized for every unit that can be claimed
+        xTaskNotifyGive(sched->task);
+        result = HANDOFF_TO_UNIT;
+    }
+#else
+    if (units->idleMask != 0)
+    {
+        // Claim an idle unit in O(1) and give it the event directly
+        uint32_t unit = 31U - __CLZ(units->idleMask);
+        units->idleMask &= ~(1UL << unit);
+        xTaskNotify(units->unitTasks[unit], UNIT_NOTIFY_HANDOFF | handle, eSetBits);
+        result = HANDOFF_TO_UNIT;
+    }
+#endif
+    else if (preemptionEnabled && severity >= PREEMPT_MIN_SEVERITY &&
+             PrioQueue_SpacesAvailable(xQueue) > (UBaseType_t)units->requeuePending + 1U &&
+             (victim = ResourceUnit_FindVictim(department, severity)) >= 0 &&
+             PrioQueue_Send(xQueue, &handle, severity, 0) == pdPASS)
+    {
+        // Queued ahead of every less severe call; the victim hands its call back into the kept slot
+        units->requeuePending++;
+        ResourceUnit_SignalPreempt(department, (uint16_t)victim);
+        result = HANDOFF_PREEMPTED;
+    }
+    else if (PrioQueue_SpacesAvailable(xQueue) > units->requeuePending && PrioQueue_Send(xQueue, &handle, severity, 0) == pdPASS)
+    {
+        result = HANDOFF_QUEUED;
+    }
+    else
+    {
+        result = HANDOFF_REJECTED;
+    }
+    (void)xTaskResumeAll();
+
+    return result;
+}
+
+void ResourceUnit_SetPreemption(BaseType_t xEnabled)
+{
+    preemptionEnabled = xEnabled ? pdTRUE : pdFALSE;
+}
+
+BaseType_t ResourceUnit_GetPreemption(void)
+{
+    return preemptionEnabled;
+}
+
+void ResourceUnit_GetStatus(uint8_t department, DeptUnitStatus_t *status)
+{
+    const DeptUnits_t *units = &deptUnits[department];
+    uint32_t meanScaled;
+
+    configASSERT(department < DEPT_COUNT);
+#if UNIT_MODEL == UNIT_MODEL_SCHEDULER
+    status->idleMask = 0;
+    status->idleUnits = units->idleCount;
+#else
+    status->idleMask = units->idleMask;
+    status->idleUnits = (uint16_t)__builtin_popcount(status->idleMask);
+#endif
+    status->numUnits = units->numUnits;
+
+    meanScaled = units->meanServiceScaled;
+    if (meanScaled == 0)
+    {
+        // No call served yet: assume the middle of the configured range
+        status->meanServiceTicks = TimeBase_MsToTicks((MIN_TASK_DURATION_MS + MAX_TASK_DURATION_MS) / 2);
+    }
+    else
+    {
+        status->meanServiceTicks = meanScaled >> SERVICE_TIME_EWMA_SHIFT;
+    }
+}
+
+void ResourceUnit_ScanUnits(uint8_t department, UnitScan_t *scan)
+{
+    const DeptUnits_t *units = &deptUnits[department];
+    const TickType_t now = xTaskGetTickCount();
+    const TickType_t nearlyFreeTicks = TimeBase_SimToWallTicks(TimeBase_MsToTicks(UNIT_NEARLY_FREE_MS));
+    TickType_t soonest = portMAX_DELAY;
+    uint16_t i;
+
+    configASSERT(department < DEPT_COUNT);
+    scan->nearlyFreeUnits = 0;
+    for (i = 0; i < units->numUnits; ++i)
+    {
+        const uint32_t state = units->unitStates[i]; // One atomic word per unit, no lock
+
+        if (UnitLifecycle_IsBusy(UnitState_Phase(state)))
+        {
+            TickType_t remaining = UnitState_TicksUntilClear(state, now);
+            if (remaining < soonest)
+            {
+                soonest = remaining;
+            }
+            if (remaining <= nearlyFreeTicks)
+            {
+                scan->nearlyFreeUnits++;
+            }
+        }
+    }
+    scan->soonestClearTicks = (soonest == portMAX_DELAY) ? 0 : soonest * TimeBase_GetDilation(); // Simulated ticks
+}
+
+const volatile uint32_t *ResourceUnit_GetUnitStates(uint8_t department, uint16_t *pNumUnits)
+{
+    configASSERT(department < DEPT_COUNT);
+    *pNumUnits = deptUnits[department].numUnits;
+    return deptUnits[department].unitStates;
+}
+
+BaseType_t ResourceUnit_GetUtilization(uint8_t department, uint16_t unit, UnitUtilization_t *out)
+{
+    configASSERT(department < DEPT_COUNT);
+    if (unit >= deptUnits[department].numUnits)
+    {
+        return pdFAIL;
+    }
+    Utilization_GetUnit(&deptUnits[department].unitUtil[unit], out);
+    return pdPASS;
+}
+
+#if UNIT_MODEL == UNIT_MODEL_TASK
+/**
+ * @brief Timing-wheel callback: a unit's phase is over, wake its task.
+ */
+static void ResourceUnit_PhaseDoneFromISR(TimerWheelTimer_t *timer, BaseType_t *pxHigherPriorityTaskWoken)
+{
+    (void)xTaskNotifyFromISR((TaskHandle_t)timer->context, UNIT_NOTIFY_TIMER, eSetBits, pxHigherPriorityTaskWoken);
+}
+
+/**
+ * @brief Runs one phase on the timing wheel and blocks until it is over.
+ *
+ * In a phase that can be pre-empted, a pre-emption cancels the phase timer and
+ * ends the wait early. A pre-emption notification whose preemptMask bit is
+ * already clear is left over from a call that ended first, and is ignored.
+ *
+ * @return pdTRUE when the phase is over, pdFALSE if the unit was pre-empted.
+ */
+static BaseType_t ResourceUnit_WaitPhase(const DeptUnits_t *units, uint32_t unitBit, TimerWheelTimer_t *timer, TickType_t ticks,
+                                         UnitPhase_t phase)
+{
+    uint32_t notifiedValue = 0;
+
+    TimerWheel_Start(timer, ticks);
+    while ((notifiedValue & UNIT_NOTIFY_TIMER) == 0)
+    {
+        (void)xTaskNotifyWait(0, UNIT_NOTIFY_TIMER | UNIT_NOTIFY_PREEMPT, &notifiedValue, portMAX_DELAY);
+        if ((notifiedValue & UNIT_NOTIFY_PREEMPT) != 0 && (units->preemptMask & unitBit) != 0 && UnitLifecycle_IsPreemptible(phase))
+        {
+            if (TimerWheel_Stop(timer) == pdFALSE)
+            {
+                (void)xTaskNotifyWait(UNIT_NOTIFY_TIMER, UNIT_NOTIFY_TIMER, NULL, 0); // Fired as well: drop the expiry
+            }
+            return pdFALSE;
+        }
+    }
+    return pdTRUE;
+}
+
+// --- Task Function ---
 
 /**
  * @brief The main function for an individual Resource Unit task.
  *
- * Waits for an event on the shared department queue, simulates handling the call,
- * and then waits for the next event. The task itself represents the resource.
+ * Takes the next event from the shared department queue if one is waiting;
+ * otherwise marks itself idle and waits for a direct hand-off from the
+ * dispatcher (task notification). Runs the call through its lifecycle phases,
+ * releases the event when the call is cleared, and heads back to the station,
+ * staying available for a new call on the way. A pre-empted unit hands its call
+ * back to the queue instead and goes straight on to the next one. The task
+ * itself represents the resource.
  *
  * @param pvParameters A pointer to a ResourceTaskParams_t structure.
  */
@@ -48,74 +605,452 @@ void ResourceUnit_Task(void *pvParameters)
     configASSERT(pvParameters != NULL);
 
     ResourceTaskParams_t *params = (ResourceTaskParams_t *)pvParameters;
-    QueueHandle_t xDepartmentQueue = params->xDepartmentQueue;
+    PrioQueueHandle_t xDepartmentQueue = params->xDepartmentQueue;
+    DeptUnits_t *units = &deptUnits[params->departmentType];
+    const uint32_t unitBit = 1UL << params->unitIndex;
     const char *taskName = pcTaskGetName(NULL); // Get task name assigned during creation
 
-    EmergencyEvent_t receivedEvent;
+    EventHandle_t receivedHandle;
+    EmergencyEvent_t *receivedEvent;
     BaseType_t xQueueStatus;
-    uint32_t taskDurationTicks;
+    BaseType_t xPhaseDone;
+    uint32_t notifiedValue;
+    UnitMission_t mission;
+    UnitPhase_t phase = UNIT_PHASE_AVAILABLE;
+    TickType_t clearTick;
+    TimerWheelTimer_t phaseTimer;
+
+    configASSERT(params->departmentType < DEPT_COUNT && params->unitIndex < MAX_UNITS_PER_DEPT);
+    units->unitTasks[params->unitIndex] = xTaskGetCurrentTaskHandle();
+    TimerWheel_InitTimer(&phaseTimer, ResourceUnit_PhaseDoneFromISR, units->unitTasks[params->unitIndex]);
+    units->unitStates[params->unitIndex] = UnitState_Pack(UNIT_PHASE_AVAILABLE, 0);
+    units->unitCalls[params->unitIndex] = EVENT_HANDLE_INVALID;
+    Utilization_InitUnit(&units->unitUtil[params->unitIndex], params->departmentType);
+    taskENTER_CRITICAL();
+    units->numUnits++;
+    taskEXIT_CRITICAL();
 
     LogInfo("%s Task started, listening on its queue.\r\n", taskName);
 
     while (1)
     {
-        // 1. Wait indefinitely for an event on the SHARED department queue
-        LogDebug("%s waiting for event...\r\n", taskName);
-        xQueueStatus = xQueueReceive(xDepartmentQueue, &receivedEvent, portMAX_DELAY);
+        // 1. Serve the backlog first (most severe pending call first). If the shared
+        //    queue is empty, publish this unit as idle in the same atomic step.
+        vTaskSuspendAll();
+        if ((units->preemptMask & unitBit) != 0)
+        {
+            // The last call ended before the pre-emption was seen: nothing to hand back
+            units->preemptMask &= ~unitBit;
+            units->requeuePending--;
+        }
+        xQueueStatus = PrioQueue_Receive(xDepartmentQueue, &receivedHandle, 0);
+        if (xQueueStatus != pdPASS)
+        {
+            units->idleMask |= unitBit;
+        }
+        (void)xTaskResumeAll();
 
         if (xQueueStatus == pdPASS)
         {
-            // --- Event Received ---
-            // This specific task instance is now "busy"
-            LogInfo("%s received event code %d. Processing...\r\n", taskName, receivedEvent.eventCode);
+            // A slot was freed; let the dispatcher re-offer anything it parked for us
+            Dispatcher_NotifyDrained(params->departmentType);
+        }
+        else
+        {
+            // 2. Idle: wait for the dispatcher to hand an event straight to this unit.
+            //    A returning unit also wakes when it is back at the station.
+            LogDebug("%s %s, waiting for event...\r\n", taskName, UnitLifecycle_PhaseName(phase));
+            do
+            {
+                (void)xTaskNotifyWait(0, 0xFFFFFFFFUL, &notifiedValue, portMAX_DELAY);
+                if ((notifiedValue & UNIT_NOTIFY_TIMER) != 0 && phase == UNIT_PHASE_RETURNING)
+                {
+                    phase = UNIT_PHASE_AVAILABLE;
+                    ResourceUnit_SetPhase(units, params->unitIndex, phase, 0);
+                    LogDebug("%s back at the station.\r\n", taskName);
+                }
+            } while ((notifiedValue & UNIT_NOTIFY_HANDOFF) == 0);
+            receivedHandle = (EventHandle_t)(notifiedValue & UNIT_NOTIFY_HANDLE_MASK);
+        }
 
-            // 2. Simulate task execution time
-            taskDurationTicks = GetRandomTaskDurationTicks();
-            LogDebug("%s task duration: %lu ticks (%lu ms)\r\n", taskName, taskDurationTicks, taskDurationTicks * EVENT_TIMER_TICK_MS);
-            vTaskDelay(taskDurationTicks); // Simulate work being done
+        // --- Event Received ---
+        if (phase == UNIT_PHASE_RETURNING)
+        {
+            // Re-tasked on the way back: drop the return trip, and its expiry if it just fired
+            if (TimerWheel_Stop(&phaseTimer) == pdFALSE)
+            {
+                (void)xTaskNotifyWait(UNIT_NOTIFY_TIMER, UNIT_NOTIFY_TIMER, NULL, 0);
+            }
+            LogDebug("%s re-tasked while returning.\r\n", taskName);
+        }
+        receivedEvent = EventPool_Get(receivedHandle);
+        units->unitCalls[params->unitIndex] = receivedHandle; // From now on a pre-emption candidate
+        receivedEvent->stamps[EVENT_STAGE_PICKED_UP] = TimeBase_SimNowUs();
+        LogInfo("%s received event code %d (severity %d). Processing...\r\n", taskName, receivedEvent->eventCode, receivedEvent->severity);
 
-            LogInfo("%s finished processing call %d. Becoming idle.\r\n", taskName, receivedEvent.eventCode);
-            // --- Event Processed, task becomes implicitly "idle" by looping back ---
+        // 3. Plan the mission and run its phases on the timing wheel (time-dilated)
+        ResourceUnit_RecordServiceTime(units, UnitLifecycle_PlanMission(params->departmentType, receivedEvent, &mission));
+        clearTick = xTaskGetTickCount() + UnitLifecycle_BusyTicks(&mission);
+        xPhaseDone = pdTRUE;
+        for (phase = UnitLifecycle_NextPhase(&mission, UNIT_PHASE_AVAILABLE); phase != UNIT_PHASE_RETURNING;
+             phase = UnitLifecycle_NextPhase(&mission, phase))
+        {
+            ResourceUnit_SetPhase(units, params->unitIndex, phase, clearTick);
+            if (phase == UNIT_PHASE_ON_SCENE)
+            {
+                receivedEvent->stamps[EVENT_STAGE_ON_SCENE] = TimeBase_SimNowUs();
+            }
+            LogDebug("%s %s for %u ticks\r\n", taskName, UnitLifecycle_PhaseName(phase), mission.phaseTicks[phase]);
+            xPhaseDone = ResourceUnit_WaitPhase(units, unitBit, &phaseTimer, mission.phaseTicks[phase], phase);
+            if (xPhaseDone == pdFALSE)
+            {
+                break;
+            }
+        }
+        units->unitCalls[params->unitIndex] = EVENT_HANDLE_INVALID; // Before the record is re-queued or recycled
+
+        if (xPhaseDone == pdFALSE)
+        {
+            // Pre-empted: the call goes back to the queue with the work done, this unit takes a more severe one
+            LogInfo("%s pre-empted %s, re-queuing call %d.\r\n", taskName, UnitLifecycle_PhaseName(phase), receivedEvent->eventCode);
+            vTaskSuspendAll();
+            units->preemptMask &= ~unitBit;
+            ResourceUnit_RequeueLocked(units, xDepartmentQueue, receivedHandle, phase);
+            (void)xTaskResumeAll();
         }
         else
         {
-            // Error receiving from queue? Should not happen with portMAX_DELAY
-            LogError("%s failed to receive from queue!\r\n", taskName);
-            // Avoid busy-waiting in case of error, delay slightly
-            vTaskDelay(pdMS_TO_TICKS(100));
+            receivedEvent->stamps[EVENT_STAGE_COMPLETED] = TimeBase_SimNowUs();
+            LatencyStats_Record(params->departmentType, receivedEvent);
+            LogInfo("%s finished processing call %d. Returning.\r\n", taskName, receivedEvent->eventCode);
+            EventPool_Release(receivedHandle); // The event is complete, recycle its record
         }
+
+        // 4. Head back to the station; the unit is available again (step 1) on the way
+        ResourceUnit_SetPhase(units, params->unitIndex, UNIT_PHASE_RETURNING, 0);
+        TimerWheel_Start(&phaseTimer, mission.phaseTicks[UNIT_PHASE_RETURNING]);
     }
 }
+#endif /* UNIT_MODEL == UNIT_MODEL_TASK */
 
-uint32_t GetRandomTaskDurationTicks(void)
+#if UNIT_MODEL == UNIT_MODEL_SCHEDULER
+// --- Department Scheduler ---
+
+/**
+ * @brief Timing-wheel callback: a unit's phase is over, queue it for the scheduler task.
+ */
+static void ResourceUnit_PhaseDueFromISR(TimerWheelTimer_t *timer, BaseType_t *pxHigherPriorityTaskWoken)
 {
-// Check if configuration values are defined
-#if defined(MIN_TASK_DURATION_TICKS) && defined(MAX_TASK_DURATION_TICKS)
-// Ensure min is not greater than max
-#if MIN_TASK_DURATION_TICKS > MAX_TASK_DURATION_TICKS
-#error "MIN_TASK_DURATION_TICKS cannot be greater than MAX_TASK_DURATION_TICKS in project_config.h"
-    return pdMS_TO_TICKS(500); // Fallback
-#endif
+    DeptScheduler_t *sched = (DeptScheduler_t *)timer->context;
+    UnitRecord_t *record = (UnitRecord_t *)timer; // phaseTimer is the first member
+
+    record->timerFired = 1;
+    ResourceUnit_QueueExpiredLocked(sched, record); // The tick hook holds the interrupt mask
+    vTaskNotifyGiveFromISR(sched->task, pxHigherPriorityTaskWoken);
+}
+
+/**
+ * @brief Cancels a unit's running phase; an expiry already queued becomes stale.
+ */
+static void ResourceUnit_CancelPhase(UnitRecord_t *record)
+{
+    taskENTER_CRITICAL();
+    (void)TimerWheel_Stop(&record->phaseTimer);
+    record->timerFired = 0;
+    taskEXIT_CRITICAL();
+}
+
+/**
+ * @brief Moves a unit into a phase: publishes it and arms the phase timer.
+ */
+static void ResourceUnit_EnterPhase(DeptScheduler_t *sched, uint16_t unit, UnitPhase_t phase)
+{
+    UnitRecord_t *record = &sched->records[unit];
+    DeptUnits_t *units = &deptUnits[sched->department];
+
+    record->phase = (uint8_t)phase;
+    ResourceUnit_SetPhase(units, unit, phase, UnitLifecycle_IsBusy(phase) ? UnitState_ClearTick(units->unitStates[unit]) : 0);
+    ResourceUnit_IndexVictim(sched, unit);
+    if (phase == UNIT_PHASE_ON_SCENE)
+    {
+        EventPool_Get(record->handle)->stamps[EVENT_STAGE_ON_SCENE] = TimeBase_SimNowUs();
+    }
+    LogDebug("%s unit %u %s for %u ticks\r\n", sched->name, unit + 1U, UnitLifecycle_PhaseName(phase), record->mission.phaseTicks[phase]);
+    TimerWheel_Start(&record->phaseTimer, record->mission.phaseTicks[phase]);
+}
+
+/**
+ * @brief Starts serving a call on a unit: plans its mission and enters the first phase.
+ */
+static void ResourceUnit_StartCall(DeptScheduler_t *sched, uint16_t unit, EventHandle_t handle)
+{
+    UnitRecord_t *record = &sched->records[unit];
+    EmergencyEvent_t *event = EventPool_Get(handle);
+    DeptUnits_t *units = &deptUnits[sched->department];
+
+    if (record->phase == UNIT_PHASE_RETURNING)
+    {
+        ResourceUnit_CancelPhase(record); // Re-tasked on the way back
+        LogDebug("%s unit %u re-tasked while returning.\r\n", sched->name, unit + 1U);
+    }
+    event->stamps[EVENT_STAGE_PICKED_UP] = TimeBase_SimNowUs();
+    LogInfo("%s unit %u received event code %d (severity %d). Processing...\r\n", sched->name, unit + 1U, event->eventCode, event->severity);
+
+    record->handle = handle;
+    ResourceUnit_RecordServiceTime(units, UnitLifecycle_PlanMission(sched->department, event, &record->mission));
+    units->unitStates[unit] = UnitState_Pack(UNIT_PHASE_AVAILABLE, xTaskGetTickCount() + UnitLifecycle_BusyTicks(&record->mission));
+    ResourceUnit_EnterPhase(sched, unit, UnitLifecycle_NextPhase(&record->mission, UNIT_PHASE_AVAILABLE));
+}
+
+/**
+ * @brief Gives a unit without a call the next queued call, or sends it back.
+ */
+static void ResourceUnit_NextCall(DeptScheduler_t *sched, uint16_t unit)
+{
+    DeptUnits_t *units = &deptUnits[sched->department];
+    UnitRecord_t *record = &sched->records[unit];
+    EventHandle_t nextHandle;
+    BaseType_t xQueueStatus;
+
+    // Same rule as a unit task: backlog first, otherwise available in the same atomic step
+    vTaskSuspendAll();
+    if (record->preemptPending)
+    {
+        // The call ended before the pre-emption was handled: nothing to hand back
+        record->preemptPending = 0;
+        units->requeuePending--;
+    }
+    xQueueStatus = PrioQueue_Receive(sched->xQueue, &nextHandle, 0);
+    if (xQueueStatus != pdPASS)
+    {
+        sched->idleStack[sched->idleTop++] = unit;
+        units->idleCount++;
+    }
+    (void)xTaskResumeAll();
+
+    if (xQueueStatus == pdPASS)
+    {
+        Dispatcher_NotifyDrained(sched->department);
+        ResourceUnit_StartCall(sched, unit, nextHandle);
+    }
+    else
+    {
+        ResourceUnit_EnterPhase(sched, unit, UNIT_PHASE_RETURNING); // Still on the idle stack, can be re-tasked
+    }
+}
 
-    // Calculate the range of possible durations
-    uint32_t range = MAX_TASK_DURATION_TICKS - MIN_TASK_DURATION_TICKS + 1;
+/**
+ * @brief Clears a unit's call, then gives it the next queued call or sends it back.
+ */
+static void ResourceUnit_FinishCall(DeptScheduler_t *sched, uint16_t unit)
+{
+    UnitRecord_t *record = &sched->records[unit];
+    const EventHandle_t handle = record->handle;
+    EmergencyEvent_t *event = EventPool_Get(handle);
+
+    event->stamps[EVENT_STAGE_COMPLETED] = TimeBase_SimNowUs();
+    LatencyStats_Record(sched->department, event);
+    LogInfo("%s unit %u finished processing call %d.\r\n", sched->name, unit + 1U, event->eventCode);
+    taskENTER_CRITICAL();
+    ResourceUnit_UnindexVictimLocked(sched, record); // No longer a pre-emption candidate
+    record->handle = EVENT_HANDLE_INVALID;
+    taskEXIT_CRITICAL();
+    EventPool_Release(handle);
+
+    ResourceUnit_NextCall(sched, unit);
+}
+
+/**
+ * @brief Interrupts a unit's call: hands it back to the queue and takes the most severe queued call.
+ */
+static void ResourceUnit_Preempt(DeptScheduler_t *sched, uint16_t unit)
+{
+    UnitRecord_t *record = &sched->records[unit];
+    const EventHandle_t handle = record->handle;
+
+    LogInfo("%s unit %u pre-empted %s, re-queuing call %d.\r\n", sched->name, unit + 1U,
+            UnitLifecycle_PhaseName(record->phase), EventPool_Get(handle)->eventCode);
+    ResourceUnit_CancelPhase(record);
+    record->handle = EVENT_HANDLE_INVALID;
 
-    // --- Option 1: Use Hardware RNG (Preferred if available) ---
+    vTaskSuspendAll();
+    record->preemptPending = 0;
+    ResourceUnit_RequeueLocked(&deptUnits[sched->department], sched->xQueue, handle, (UnitPhase_t)record->phase);
+    (void)xTaskResumeAll();
 
-    uint32_t randomValue;
-    if (HAL_RNG_GenerateRandomNumber(&hrng, &randomValue) == HAL_OK)
+    ResourceUnit_NextCall(sched, unit);
+}
+
+/**
+ * @brief Handles the end of a unit's phase.
+ */
+static void ResourceUnit_PhaseOver(DeptScheduler_t *sched, uint16_t unit)
+{
+    UnitRecord_t *record = &sched->records[unit];
+    UnitPhase_t next = UnitLifecycle_NextPhase(&record->mission, (UnitPhase_t)record->phase);
+
+    if (record->phase == UNIT_PHASE_RETURNING)
+    {
+        record->phase = UNIT_PHASE_AVAILABLE;
+        ResourceUnit_SetPhase(&deptUnits[sched->department], unit, UNIT_PHASE_AVAILABLE, 0);
+        LogDebug("%s unit %u back at the station.\r\n", sched->name, unit + 1U);
+    }
+    else if (next == UNIT_PHASE_RETURNING)
     {
-        // Scale the 32-bit random number to the desired range
-        return (randomValue % range) + MIN_TASK_DURATION_TICKS;
+        ResourceUnit_FinishCall(sched, unit);
     }
     else
     {
-        // Fallback to software RNG or default if hardware RNG fails
-        // LogError("Hardware RNG failed in GetRandomTaskDurationTicks, using rand().\r\n"); // Logging here might need mutex
-        return (rand() % range) + MIN_TASK_DURATION_TICKS;
+        ResourceUnit_EnterPhase(sched, unit, next);
+    }
+}
+
+/**
+ * @brief Scheduler task: simulates every unit of one department.
+ *
+ * Sleeps until the timing wheel reports a unit whose phase is over or the
+ * dispatcher hands off a call or pre-empts a unit.
+ *
+ * @param pvParameters Pointer to the department's DeptScheduler_t.
+ */
+static void ResourceUnit_SchedulerTask(void *pvParameters)
+{
+    DeptScheduler_t *sched = (DeptScheduler_t *)pvParameters;
+    EventHandle_t handle;
+    UnitRecord_t *record, *next;
+    uint8_t fired;
+
+    LogInfo("%s scheduler started with %u units.\r\n", sched->name, deptUnits[sched->department].numUnits);
+
+    while (1)
+    {
+        // 1. Bind calls handed off by the dispatcher to idle (or returning) units
+        while (SpscRing_Pop(&sched->startRing, &handle) == pdPASS)
+        {
+            configASSERT(sched->idleTop > 0); // Guaranteed by the claim on idleCount
+            ResourceUnit_StartCall(sched, sched->idleStack[--sched->idleTop], handle);
+        }
+
+        // 2. Advance every unit whose phase is over or that was pre-empted (one list, taken in one go)
+        taskENTER_CRITICAL();
+        record = sched->expiredHead;
+        sched->expiredHead = NULL;
+        sched->expiredTail = NULL;
+        taskEXIT_CRITICAL();
+        while (record != NULL)
+        {
+            taskENTER_CRITICAL();
+            next = record->expiredNext;
+            record->expiredQueued = 0;
+            fired = record->timerFired;
+            record->timerFired = 0;
+            taskEXIT_CRITICAL();
+            if (record->preemptPending && UnitLifecycle_IsPreemptible((UnitPhase_t)record->phase))
+            {
+                ResourceUnit_Preempt(sched, (uint16_t)(record - sched->records));
+            }
+            else if (fired)
+            {
+                ResourceUnit_PhaseOver(sched, (uint16_t)(record - sched->records));
+            }
+            record = next;
+        }
+
+        // 3. Sleep until the next phase ends or the next hand-off
+        (void)ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    }
+}
+
+BaseType_t ResourceUnit_CreateScheduler(uint8_t department, PrioQueueHandle_t xQueue, uint16_t numUnits, const char *name)
+{
+    DeptScheduler_t *sched = &deptSchedulers[department];
+    const uint16_t maxBusy = (numUnits < EVENT_POOL_SIZE) ? numUnits : EVENT_POOL_SIZE;
+    uint32_t ringLength = 1;
+    uint8_t *block;
+    uint16_t i;
+
+    configASSERT(department < DEPT_COUNT && numUnits > 0 && numUnits <= MAX_SCHEDULED_UNITS_PER_DEPT);
+    while (ringLength < maxBusy)
+    {
+        ringLength <<= 1; // The ring needs a power-of-two length
+    }
+
+    // One block per department: accounting (8-byte aligned first), records, state words, idle stack, ring slots
+    block = pvPortMalloc((numUnits * sizeof(UnitUtil_t)) + (numUnits * sizeof(UnitRecord_t)) + (numUnits * sizeof(uint32_t)) +
+                         (numUnits * sizeof(uint16_t)) + (ringLength * sizeof(EventHandle_t)));
+    if (block == NULL)
+    {
+        return pdFAIL;
     }
+    deptUnits[department].unitUtil = (UnitUtil_t *)block;
+    sched->records = (UnitRecord_t *)(deptUnits[department].unitUtil + numUnits);
+    deptUnits[department].unitStates = (volatile uint32_t *)(sched->records + numUnits);
+    sched->idleStack = (uint16_t *)(deptUnits[department].unitStates + numUnits);
+    (void)SpscRing_Init(&sched->startRing, (EventHandle_t *)(sched->idleStack + numUnits), ringLength);
+
+    for (i = 0; i < numUnits; ++i)
+    {
+        TimerWheel_InitTimer(&sched->records[i].phaseTimer, ResourceUnit_PhaseDueFromISR, sched);
+        sched->records[i].expiredNext = NULL;
+        sched->records[i].handle = EVENT_HANDLE_INVALID;
+        sched->records[i].phase = UNIT_PHASE_AVAILABLE;
+        sched->records[i].expiredQueued = 0;
+        sched->records[i].timerFired = 0;
+        sched->records[i].preemptPending = 0;
+        sched->records[i].victimBucket = VICTIM_BUCKET_NONE;
+        deptUnits[department].unitStates[i] = UnitState_Pack(UNIT_PHASE_AVAILABLE, 0);
+        Utilization_InitUnit(&deptUnits[department].unitUtil[i], department);
+        sched->idleStack[i] = (uint16_t)(numUnits - 1U - i); // Unit 1 is handed out first
+    }
+    for (i = 0; i < VICTIM_BUCKET_COUNT; ++i)
+    {
+        sched->victimHeads[i] = UNIT_INDEX_NONE;
+    }
+    sched->idleTop = numUnits;
+    sched->expiredHead = NULL;
+    sched->expiredTail = NULL;
+    sched->xQueue = xQueue;
+    sched->name = name;
+    sched->department = department;
+    deptUnits[department].numUnits = numUnits;
+    deptUnits[department].idleCount = numUnits;
+
+    if (xTaskCreate(ResourceUnit_SchedulerTask, name, TASK_STACK_SIZE_DEPARTMENT, sched, TASK_PRIO_DEPT_LOW, &sched->task) != pdPASS)
+    {
+        deptUnits[department].idleCount = 0;
+        deptUnits[department].numUnits = 0;
+        vPortFree(block);
+        return pdFAIL;
+    }
+    return pdPASS;
+}
+#endif /* UNIT_MODEL == UNIT_MODEL_SCHEDULER */
+
+uint32_t GetRandomTaskDurationTicks(uint8_t department)
+{
+#if SERVICE_TIME_MODEL == SERVICE_TIME_TABLE
+    // Inverse-CDF lookup in the department's service-time table
+    uint32_t ticks = TimeBase_MsToTicks(ServiceTime_DrawMs(department, RngService_Next()));
+
+    return (ticks > 0) ? ticks : 1U;
+// Check if configuration values are defined
+#elif defined(MIN_TASK_DURATION_MS) && defined(MAX_TASK_DURATION_MS)
+// Ensure min is not greater than max
+#if MIN_TASK_DURATION_MS > MAX_TASK_DURATION_MS
+#error "MIN_TASK_DURATION_MS cannot be greater than MAX_TASK_DURATION_MS in project_config.h"
+    return TimeBase_MsToTicks(500); // Fallback
+#endif
+
+    // Calculate the range of possible durations (in ticks, not the old 10 ms "timer ticks")
+    const uint32_t minTicks = TimeBase_MsToTicks(MIN_TASK_DURATION_MS);
+    uint32_t range = TimeBase_MsToTicks(MAX_TASK_DURATION_MS) - minTicks + 1;
+
+    (void)department; // Same distribution for every department
+    // Prefetched hardware random word (seeded xorshift if the ring is empty)
+    return (RngService_Next() % range) + minTicks;
 #else
     // Default fallback if config values are not defined
-    return pdMS_TO_TICKS(500); // Default to 500ms if config values missing
+    (void)department;
+    return TimeBase_MsToTicks(500); // Default to 500ms if config values missing
 #endif
 }
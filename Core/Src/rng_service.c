@@ -0,0 +1,177 @@
+/**
+ * @file rng_service.c
+ * @brief Implementation of the non-blocking random number service.
+ *
+ * The RNG interrupt produces one word per activation (HAL interrupt mode) and
+ * re-arms itself until the ring is full. Taking a word re-arms a stopped
+ * refill. All ring and HAL accesses happen inside critical sections, which
+ * also mask the RNG interrupt, so producer and consumers never overlap.
+ *
+ * With RNG_SERVICE_POLLED the ring is not used: each word is polled from the
+ * peripheral inside the critical section, which reproduces the cost the ring
+ * removes so it can be measured on the same image.
+ *
+ * @date October 15, 2026
+ * @author shayb
+ */
+
+#include "rng_service.h"
+#include "project_config.h" // For RNG_RING_LENGTH
+#include "task.h"
+#include "main.h" // For RNG_HandleTypeDef, DWT (CMSIS)
+
+#if (RNG_RING_LENGTH & (RNG_RING_LENGTH - 1)) != 0
+#error "RNG_RING_LENGTH must be a power of two"
+#endif
+
+extern RNG_HandleTypeDef hrng;
+
+static uint32_t ring[RNG_RING_LENGTH];
+static uint32_t ringHead = 0;   // Next word to serve
+static uint32_t ringCount = 0;  // Words ready
+static uint8_t refillActive = 0; // RNG interrupt armed
+static uint32_t xorshiftState = 0x2545F491UL;
+static RngServiceStats_t rngStats = {0};
+
+// --- Private Functions ---
+
+/**
+ * @brief Arms the RNG interrupt for one more word. Caller holds the critical section.
+ */
+static void RngService_KickLocked(void)
+{
+    if (!refillActive && ringCount < RNG_RING_LENGTH &&
+        HAL_RNG_GenerateRandomNumber_IT(&hrng) == HAL_OK)
+    {
+        refillActive = 1;
+    }
+}
+
+/**
+ * @brief Serves one word. Caller holds the critical section.
+ */
+static uint32_t RngService_TakeLocked(void)
+{
+    uint32_t value;
+
+#if RNG_SERVICE_MODE == RNG_SERVICE_POLLED
+    if (HAL_RNG_GenerateRandomNumber(&hrng, &value) == HAL_OK) // Busy-waits on the peripheral
+    {
+        rngStats.hardwareWords++;
+    }
+#else
+    if (ringCount > 0)
+    {
+        value = ring[ringHead];
+        ringHead = (ringHead + 1U) & (RNG_RING_LENGTH - 1U);
+        ringCount--;
+        rngStats.hardwareWords++;
+    }
+#endif
+    else
+    {
+        // xorshift32 (Marsaglia): full period over non-zero states
+        value = xorshiftState;
+        value ^= value << 13;
+        value ^= value >> 17;
+        value ^= value << 5;
+        xorshiftState = value;
+        rngStats.fallbackWords++;
+    }
+
+#if RNG_SERVICE_MODE == RNG_SERVICE_RING
+    RngService_KickLocked();
+#endif
+    return value;
+}
+
+// --- Public Functions ---
+
+void RngService_Init(void)
+{
+    uint32_t seed = DWT->CYCCNT ^ HAL_GetUIDw0() ^ HAL_GetUIDw1() ^ HAL_GetUIDw2();
+    uint32_t hwWord;
+
+    // One polled word at boot (before the scheduler runs) strengthens the fallback seed
+    if (HAL_RNG_GenerateRandomNumber(&hrng, &hwWord) == HAL_OK)
+    {
+        seed ^= hwWord;
+    }
+    xorshiftState = (seed != 0) ? seed : 0x2545F491UL; // xorshift must not start at 0
+
+#if RNG_SERVICE_MODE == RNG_SERVICE_RING
+    taskENTER_CRITICAL();
+    RngService_KickLocked();
+    taskEXIT_CRITICAL();
+#endif
+}
+
+uint32_t RngService_Next(void)
+{
+    uint32_t value;
+
+    taskENTER_CRITICAL();
+    value = RngService_TakeLocked();
+    taskEXIT_CRITICAL();
+    return value;
+}
+
+uint32_t RngService_NextFromISR(void)
+{
+    UBaseType_t uxSavedInterruptStatus;
+    uint32_t value;
+
+    uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+    value = RngService_TakeLocked();
+    taskEXIT_CRITICAL_FROM_ISR(uxSavedInterruptStatus);
+    return value;
+}
+
+void RngService_GetStats(RngServiceStats_t *stats)
+{
+    taskENTER_CRITICAL();
+    *stats = rngStats;
+    taskEXIT_CRITICAL();
+}
+
+// --- HAL Callback Implementation ---
+
+/**
+ * @brief Data ready callback: stores the word and re-arms until the ring is full.
+ */
+void HAL_RNG_ReadyDataCallback(RNG_HandleTypeDef *hrngCb, uint32_t random32bit)
+{
+    UBaseType_t uxSavedInterruptStatus;
+
+    (void)hrngCb;
+    uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+    if (ringCount < RNG_RING_LENGTH)
+    {
+        ring[(ringHead + ringCount) & (RNG_RING_LENGTH - 1U)] = random32bit;
+        ringCount++;
+    }
+    refillActive = 0;
+    RngService_KickLocked();
+    taskEXIT_CRITICAL_FROM_ISR(uxSavedInterruptStatus);
+}
+
+/**
+ * @brief Error callback: restarts the peripheral; consumers use the fallback meanwhile.
+ */
+void HAL_RNG_ErrorCallback(RNG_HandleTypeDef *hrngCb)
+{
+    UBaseType_t uxSavedInterruptStatus;
+
+    uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+    rngStats.hardwareErrors++;
+
+    // Seed error recovery per the reference manual: toggle RNGEN
+    __HAL_RNG_DISABLE_IT(hrngCb);
+    __HAL_RNG_DISABLE(hrngCb);
+    __HAL_RNG_ENABLE(hrngCb);
+    hrngCb->State = HAL_RNG_STATE_READY;
+    __HAL_UNLOCK(hrngCb);
+
+    refillActive = 0; // The next consumer re-arms the refill
+    taskEXIT_CRITICAL_FROM_ISR(uxSavedInterruptStatus);
+}
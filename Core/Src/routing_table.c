@@ -0,0 +1,140 @@
+/**
+ * @file routing_table.c
+ * @brief Routing rules and the table-driven routing engine.
+ *
+ * To add an event type: define its hop list below and add one line to
+ * routingTable[]. To change a fallback chain: edit the hop list. The
+ * dispatcher never needs to change.
+ *
+ * @date October 15, 2026
+ * @author shayb
+ */
+
+#include "routing_table.h"
+#include "time_base.h"
+
+/**
+ * @def ROUTE
+ * @brief Builds a routing entry from a hop array, counting the hops at compile time.
+ */
+#define ROUTE(hopArray) {(hopArray), (uint8_t)(sizeof(hopArray) / sizeof((hopArray)[0]))}
+
+// --- Hop Lists (hop 0 = primary department) ---
+
+static const RouteHop_t policeRoute[] = {
+    {DEPT_POLICE, REDIRECT_ALWAYS},
+};
+
+static const RouteHop_t ambulanceRoute[] = {
+    {DEPT_AMBULANCE, REDIRECT_IF_UNIT_IDLE},  // An ambulance is free: take it
+    {DEPT_POLICE, REDIRECT_IF_SHORTER_WAIT},  // Police first aid arrives clearly sooner
+    {DEPT_AMBULANCE, REDIRECT_IF_SPACE},      // Otherwise queue for an ambulance
+    {DEPT_POLICE, REDIRECT_IF_SPACE},         // Ambulance queue full: police as last resort
+};
+
+static const RouteHop_t fireRoute[] = {
+    {DEPT_FIRE, REDIRECT_ALWAYS},
+};
+
+// --- Routing Table (indexed by event code, stored in flash) ---
+
+static const RouteEntry_t routingTable[EVENT_CODE_COUNT] = {
+    [EVENT_CODE_POLICE] = ROUTE(policeRoute),
+    [EVENT_CODE_AMBULANCE] = ROUTE(ambulanceRoute),
+    [EVENT_CODE_FIRE_DEPT] = ROUTE(fireRoute),
+};
+
+static const char *const deptNames[DEPT_COUNT] = {
+    [DEPT_POLICE] = "Police",
+    [DEPT_AMBULANCE] = "Ambulance",
+    [DEPT_FIRE] = "FireDept",
+};
+
+// --- Public Functions ---
+
+const RouteEntry_t *Routing_Lookup(uint8_t eventCode)
+{
+    if (eventCode >= EVENT_CODE_COUNT || routingTable[eventCode].numHops == 0)
+    {
+        return NULL;
+    }
+    return &routingTable[eventCode];
+}
+
+uint32_t Routing_EstimatedWaitTicks(const DeptLoad_t *load)
+{
+    if (load->idleUnits > 0)
+    {
+        return 0;
+    }
+    if (load->numUnits == 0)
+    {
+        return portMAX_DELAY; // Unstaffed department never serves
+    }
+    if (load->queued == 0)
+    {
+        return load->soonestClearTicks; // First in line: exactly until the first unit clears
+    }
+    return (load->meanServiceTicks * (load->queued + 1U)) / load->numUnits;
+}
+
+uint8_t Routing_SelectHop(const RouteEntry_t *route, const DeptLoad_t load[DEPT_COUNT])
+{
+    const uint32_t marginTicks = TimeBase_MsToTicks(REDIRECT_WAIT_MARGIN_MS);
+    uint32_t primaryWait = 0;
+    uint8_t primaryWaitKnown = 0;
+    uint8_t i;
+
+    for (i = 0; i < route->numHops; ++i)
+    {
+        const DeptLoad_t *deptLoad = &load[route->hops[i].department];
+
+        switch (route->hops[i].policy)
+        {
+        case REDIRECT_IF_SPACE:
+            if (deptLoad->idleUnits > 0 || deptLoad->freeSlots > 0)
+            {
+                return i;
+            }
+            break;
+        case REDIRECT_IF_IDLE:
+            if (deptLoad->queued == 0)
+            {
+                return i;
+            }
+            break;
+        case REDIRECT_IF_UNIT_IDLE:
+            if (deptLoad->idleUnits > 0 || deptLoad->nearlyFreeUnits > deptLoad->queued)
+            {
+                return i;
+            }
+            break;
+        case REDIRECT_IF_SHORTER_WAIT:
+            if (!primaryWaitKnown)
+            {
+                primaryWait = Routing_EstimatedWaitTicks(&load[route->hops[0].department]);
+                primaryWaitKnown = 1;
+            }
+            if (deptLoad->freeSlots > 0 || deptLoad->idleUnits > 0)
+            {
+                uint32_t wait = Routing_EstimatedWaitTicks(deptLoad);
+                if (wait < primaryWait && (primaryWait - wait) >= marginTicks)
+                {
+                    return i;
+                }
+            }
+            break;
+        case REDIRECT_ALWAYS:
+        default:
+            return i;
+        }
+    }
+
+    // Nobody accepted: wait in the primary department
+    return 0;
+}
+
+const char *Routing_DeptName(uint8_t department)
+{
+    return (department < DEPT_COUNT) ? deptNames[department] : "Unknown";
+}
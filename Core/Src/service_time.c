@@ -0,0 +1,33 @@
+/**
+ * @file service_time.c
+ * @brief Inverse-CDF sampling of the per-department service-time tables.
+ *
+ * The top SERVICE_TIME_TABLE_BITS of the random word select the interval of the
+ * quantile table and the next SERVICE_TIME_INTERP_BITS interpolate inside it,
+ * the same scheme the arrival models use for their exponential table.
+ *
+ * @date October 15, 2026
+ * @author shayb
+ */
+
+#include "service_time.h"
+
+#define SERVICE_TIME_INTERP_BITS 8
+
+// --- Public Functions ---
+
+uint32_t ServiceTime_DrawMs(uint8_t department, uint32_t randomValue)
+{
+    const uint32_t *table = serviceTimeTables[department].quantileMs;
+    uint32_t index = randomValue >> (32U - SERVICE_TIME_TABLE_BITS);
+    uint32_t frac = (randomValue >> (32U - SERVICE_TIME_TABLE_BITS - SERVICE_TIME_INTERP_BITS)) & ((1U << SERVICE_TIME_INTERP_BITS) - 1U);
+    uint32_t lo = table[index];
+    uint32_t hi = table[index + 1U];
+
+    return lo + (((hi - lo) * frac) >> SERVICE_TIME_INTERP_BITS);
+}
+
+const char *ServiceTime_Name(uint8_t department)
+{
+    return (department < DEPT_COUNT) ? serviceTimeTables[department].name : "unknown";
+}
@@ -0,0 +1,105 @@
+/**
+ * @file spsc_ring.c
+ * @brief Implementation of the lock-free single-producer/single-consumer ring.
+ *
+ * Indices run freely and wrap at 2^32; tail - head is the fill level and the
+ * low bits select the slot. Barriers per handle:
+ *
+ *   producer: write slot, DMB, publish tail, DMB, read head (wake-up check)
+ *   consumer: read slot,  DMB, publish head
+ *
+ * The barrier next to each index update keeps the slot access on the right
+ * side of it. The consumer also remembers the last tail it read (tailSeen),
+ * so it only goes back to the producer's index, with one DMB before the slots
+ * it covers, once those are used up: one acquire barrier per batch instead of
+ * one per handle.
+ *
+ * The wake-up decision needs a store-to-load barrier on both sides: the
+ * producer's after publishing tail, the consumer's before its final emptiness
+ * check, which it only takes when the tail looks unchanged. Then at least one
+ * side is guaranteed to see the other's update, so either the producer sees
+ * the ring was drained (and wakes the consumer), or the consumer sees the new
+ * tail. An event can therefore never be left in the ring with the consumer
+ * asleep. Without a wake-up flag to fill in, the producer skips its second
+ * barrier.
+ *
+ * @date October 15, 2026
+ * @author shayb
+ */
+
+#include "spsc_ring.h"
+#include "queue.h" // For errQUEUE_FULL / errQUEUE_EMPTY
+#include "main.h"  // For __DMB (CMSIS)
+
+// --- Public Functions ---
+
+BaseType_t SpscRing_Init(SpscRing_t *ring, EventHandle_t *storage, uint32_t length)
+{
+    if (length == 0 || (length & (length - 1U)) != 0)
+    {
+        return pdFAIL;
+    }
+
+    ring->items = storage;
+    ring->mask = length - 1U;
+    ring->head = 0;
+    ring->tail = 0;
+    ring->tailSeen = 0;
+    return pdPASS;
+}
+
+BaseType_t SpscRing_Push(SpscRing_t *ring, EventHandle_t handle, BaseType_t *pxWasEmpty)
+{
+    const uint32_t tail = ring->tail; // Own index, no barrier needed
+
+    if ((tail - ring->head) > ring->mask)
+    {
+        return errQUEUE_FULL;
+    }
+
+    ring->items[tail & ring->mask] = handle;
+    __DMB(); // Slot contents before the new tail
+    ring->tail = tail + 1U;
+
+    if (pxWasEmpty != NULL)
+    {
+        __DMB(); // Tail published before head is sampled for the wake-up decision
+        *pxWasEmpty = (ring->head == tail) ? pdTRUE : pdFALSE;
+    }
+    return pdPASS;
+}
+
+BaseType_t SpscRing_Pop(SpscRing_t *ring, EventHandle_t *pHandle)
+{
+    const uint32_t head = ring->head; // Own index, no barrier needed
+
+    if (head == ring->tailSeen)
+    {
+        // Every handle seen so far is consumed: look at the producer's index again
+        uint32_t tail = ring->tail;
+
+        if (tail == head)
+        {
+            __DMB(); // Head published before the final emptiness check (wake-up decision)
+            tail = ring->tail;
+            if (tail == head)
+            {
+                return errQUEUE_EMPTY;
+            }
+        }
+        ring->tailSeen = tail;
+        __DMB(); // Tail read before the slots it covers
+    }
+
+    *pHandle = ring->items[head & ring->mask];
+    __DMB(); // Slot read before the producer may reuse it
+    ring->head = head + 1U;
+    return pdPASS;
+}
+
+uint32_t SpscRing_Count(const SpscRing_t *ring)
+{
+    const uint32_t head = ring->head; // Head first: a later tail can only be larger
+
+    return ring->tail - head;
+}
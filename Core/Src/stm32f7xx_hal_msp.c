@@ -106,6 +106,9 @@ void HAL_RNG_MspInit(RNG_HandleTypeDef* hrng)
     /* Peripheral clock enable */
     __HAL_RCC_RNG_CLK_ENABLE();
     /* USER CODE BEGIN RNG_MspInit 1 */
+    /* Data-ready interrupt refills the RNG service ring; below TIM2 so it never delays event generation */
+    HAL_NVIC_SetPriority(HASH_RNG_IRQn, 6, 0);
+    HAL_NVIC_EnableIRQ(HASH_RNG_IRQn);
 
     /* USER CODE END RNG_MspInit 1 */
 
@@ -129,6 +132,7 @@ void HAL_RNG_MspDeInit(RNG_HandleTypeDef* hrng)
     /* Peripheral clock disable */
     __HAL_RCC_RNG_CLK_DISABLE();
     /* USER CODE BEGIN RNG_MspDeInit 1 */
+    HAL_NVIC_DisableIRQ(HASH_RNG_IRQn);
 
     /* USER CODE END RNG_MspDeInit 1 */
   }
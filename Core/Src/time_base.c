@@ -0,0 +1,147 @@
+/**
+ * @file time_base.c
+ * @brief Implementation of the system time base.
+ *
+ * The clock accumulates whole microseconds from the DWT cycle counter and keeps
+ * the leftover cycles for the next call, so it neither drifts nor needs a 64-bit
+ * division on the common path. If more than half a counter wrap may have passed
+ * since the previous call, the RTOS tick count tells how many wraps were missed.
+ *
+ * @date October 15, 2026
+ * @author shayb
+ */
+
+#include "time_base.h"
+#include "task.h"
+#include "main.h" // For DWT / CoreDebug (CMSIS) and SystemCoreClock
+
+#define DWT_LAR_UNLOCK_KEY 0xC5ACCE55UL // Cortex-M7 DWT software lock access key
+#define CYCLE_WRAP (1ULL << 32)
+
+_Static_assert((1000000U % configTICK_RATE_HZ) == 0, "configTICK_RATE_HZ must divide 1 MHz for exact tick conversions");
+
+static uint32_t cyclesPerUs = 1;       // CPU cycles per microsecond
+static uint32_t cyclesPerTick = 1;     // CPU cycles per RTOS tick
+static TickType_t cycleSpanTicks = 0; // Gaps shorter than this cannot hide a counter wrap
+
+// --- Clock State (updated with interrupts masked) ---
+static uint64_t nowUs = 0;         // Microseconds accounted for so far
+static uint32_t accountedCycles = 0; // CYCCNT value that nowUs corresponds to
+static TickType_t accountedTick = 0; // Tick count at the previous update
+
+// --- Simulated Clock ---
+static volatile uint32_t dilation = SIM_TIME_DILATION; // Simulated seconds per wall second
+static uint64_t simBaseUs = 0;  // Simulated time at the last rebase
+static uint64_t wallBaseUs = 0; // Wall time at the last rebase
+
+// --- Public Functions ---
+
+void TimeBase_Init(void)
+{
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk; // Power up the trace block
+    DWT->LAR = DWT_LAR_UNLOCK_KEY;                  // The M7 DWT is write-locked out of reset
+    DWT->CYCCNT = 0;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+    cyclesPerUs = SystemCoreClock / 1000000U;
+    if (cyclesPerUs == 0)
+    {
+        cyclesPerUs = 1;
+    }
+    cyclesPerTick = cyclesPerUs * TIME_US_PER_TICK;
+    // Half a counter wrap, so the tick count unambiguously says which wrap we are in
+    cycleSpanTicks = (TickType_t)((CYCLE_WRAP / 2U) / cyclesPerTick);
+
+    nowUs = 0;
+    accountedCycles = 0;
+    accountedTick = xTaskGetTickCount();
+    simBaseUs = 0;
+    wallBaseUs = 0;
+}
+
+TimeStamp_t TimeBase_NowUs(void)
+{
+    UBaseType_t uxSavedInterruptStatus;
+    uint64_t elapsedCycles, wholeUs;
+    TimeStamp_t result;
+
+    // BASEPRI masking works in thread mode as well as in ISRs
+    uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+
+    const uint32_t cycles = DWT->CYCCNT;
+    const TickType_t tick = xTaskGetTickCountFromISR();
+    const TickType_t ticks = tick - accountedTick;
+
+    elapsedCycles = (uint32_t)(cycles - accountedCycles); // Exact modulo one wrap
+    if (ticks >= cycleSpanTicks)
+    {
+        // Long gap: add the whole wraps the tick count says were missed
+        uint64_t approxCycles = (uint64_t)ticks * cyclesPerTick;
+        uint64_t wraps = (approxCycles + (CYCLE_WRAP / 2U) - elapsedCycles) >> 32;
+
+        elapsedCycles += wraps << 32;
+        wholeUs = elapsedCycles / cyclesPerUs;
+    }
+    else
+    {
+        wholeUs = (uint32_t)elapsedCycles / cyclesPerUs; // Single UDIV
+    }
+
+    nowUs += wholeUs;
+    accountedCycles += (uint32_t)(wholeUs * cyclesPerUs); // Keep the sub-microsecond remainder
+    accountedTick = tick;
+    result = nowUs;
+
+    portCLEAR_INTERRUPT_MASK_FROM_ISR(uxSavedInterruptStatus);
+    return result;
+}
+
+TimeStamp_t TimeBase_SimNowUs(void)
+{
+    UBaseType_t uxSavedInterruptStatus;
+    TimeStamp_t result;
+
+    uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR(); // Rebase must not interleave
+    result = simBaseUs + (TimeBase_NowUs() - wallBaseUs) * dilation;
+    portCLEAR_INTERRUPT_MASK_FROM_ISR(uxSavedInterruptStatus);
+    return result;
+}
+
+BaseType_t TimeBase_SetDilation(uint32_t factor)
+{
+    UBaseType_t uxSavedInterruptStatus;
+    uint64_t wallUs;
+
+    if (factor == 0)
+    {
+        return pdFAIL;
+    }
+
+    uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+    wallUs = TimeBase_NowUs();
+    simBaseUs += (wallUs - wallBaseUs) * dilation;
+    wallBaseUs = wallUs;
+    dilation = factor;
+    portCLEAR_INTERRUPT_MASK_FROM_ISR(uxSavedInterruptStatus);
+    return pdPASS;
+}
+
+uint32_t TimeBase_GetDilation(void)
+{
+    return dilation;
+}
+
+uint64_t TimeBase_SimToWallUs(uint64_t simUs)
+{
+    const uint32_t factor = dilation;
+
+    return (simUs + factor - 1U) / factor;
+}
+
+TickType_t TimeBase_SimToWallTicks(TickType_t simTicks)
+{
+    const uint32_t factor = dilation;
+    TickType_t wallTicks = (TickType_t)(((uint64_t)simTicks + factor - 1U) / factor);
+
+    return (wallTicks > 0) ? wallTicks : 1U;
+}
@@ -0,0 +1,200 @@
+/**
+ * @file timer_wheel.c
+ * @brief Implementation of the hierarchical timing wheel.
+ *
+ * A timer due in d ticks is filed by the size of d: level 0 if d < 256 (slot =
+ * expiry bits 7..0), otherwise the lowest upper level whose span covers d
+ * (slot = the expiry bits of that level). A slot of level n is visited when
+ * the wheel tick reaches the start of its block, which is always after the
+ * timer was filed and before the slot index repeats, so the timer is re-filed
+ * exactly once per level on its way down and fires on its expiry tick.
+ *
+ * All wheel state is protected by the kernel critical section: the tick hook
+ * runs at configKERNEL_INTERRUPT_PRIORITY, so taskENTER_CRITICAL() in a task
+ * is enough to keep it out, and the tick itself masks the interrupts that may
+ * call TimerWheel_StartFromISR().
+ *
+ * @date October 15, 2026
+ * @author shayb
+ */
+
+#include "timer_wheel.h"
+#include "task.h"
+
+#if !configUSE_TICK_HOOK
+#error "The timing wheel is advanced from vApplicationTickHook: set configUSE_TICK_HOOK (FREERTOS.configUSE_TICK_HOOK in the .ioc)"
+#endif
+
+#define L0_SIZE (1UL << TIMER_WHEEL_L0_BITS)
+#define L0_MASK (L0_SIZE - 1UL)
+#define LN_SIZE (1UL << TIMER_WHEEL_LN_BITS)
+#define LN_MASK (LN_SIZE - 1UL)
+#define LEVEL_SHIFT(level) (TIMER_WHEEL_L0_BITS + ((level) - 1U) * TIMER_WHEEL_LN_BITS) // Upper levels (1..)
+#define WHEEL_SPAN (1UL << LEVEL_SHIFT(TIMER_WHEEL_LEVELS))                             // Ticks the wheel can hold
+
+static TimerWheelTimer_t *level0[L0_SIZE];
+static TimerWheelTimer_t *upperLevels[TIMER_WHEEL_LEVELS - 1][LN_SIZE];
+static TickType_t wheelTick; // Last tick processed by TimerWheel_TickFromISR()
+
+// --- Private Functions ---
+
+static inline void TimerWheel_Link(TimerWheelTimer_t **head, TimerWheelTimer_t *timer)
+{
+    timer->next = *head;
+    if (*head != NULL)
+    {
+        (*head)->pprev = &timer->next;
+    }
+    *head = timer;
+    timer->pprev = head;
+}
+
+static inline void TimerWheel_Unlink(TimerWheelTimer_t *timer)
+{
+    *timer->pprev = timer->next;
+    if (timer->next != NULL)
+    {
+        timer->next->pprev = timer->pprev;
+    }
+    timer->pprev = NULL;
+}
+
+/**
+ * @brief Puts a timer in the slot matching its distance from the wheel tick.
+ */
+static void TimerWheel_File(TimerWheelTimer_t *timer)
+{
+    TickType_t slotTick = timer->expiry;
+    uint32_t level = 1;
+
+    if ((TickType_t)(slotTick - wheelTick) < L0_SIZE)
+    {
+        TimerWheel_Link(&level0[slotTick & L0_MASK], timer);
+        return;
+    }
+    if ((TickType_t)(slotTick - wheelTick) >= WHEEL_SPAN)
+    {
+        slotTick = wheelTick + WHEEL_SPAN - 1UL; // Too far: park in the farthest slot, re-filed when it comes round
+    }
+    while (level < TIMER_WHEEL_LEVELS - 1U && (TickType_t)(slotTick - wheelTick) >= (1UL << LEVEL_SHIFT(level + 1U)))
+    {
+        level++;
+    }
+    TimerWheel_Link(&upperLevels[level - 1U][(slotTick >> LEVEL_SHIFT(level)) & LN_MASK], timer);
+}
+
+/**
+ * @brief Re-files every timer of an upper-level slot one level closer.
+ */
+static void TimerWheel_Cascade(TimerWheelTimer_t **slot)
+{
+    TimerWheelTimer_t *timer = *slot;
+
+    *slot = NULL;
+    while (timer != NULL)
+    {
+        TimerWheelTimer_t *next = timer->next; // Filing overwrites the link
+        TimerWheel_File(timer);
+        timer = next;
+    }
+}
+
+static void TimerWheel_StartLocked(TimerWheelTimer_t *timer, TickType_t delayTicks)
+{
+    if (timer->pprev != NULL)
+    {
+        TimerWheel_Unlink(timer); // Restart
+    }
+    timer->expiry = wheelTick + ((delayTicks > 0) ? delayTicks : 1U);
+    TimerWheel_File(timer);
+}
+
+// --- Public Functions ---
+
+void TimerWheel_InitTimer(TimerWheelTimer_t *timer, TimerWheelCallback_t callback, void *context)
+{
+    timer->next = NULL;
+    timer->pprev = NULL;
+    timer->expiry = 0;
+    timer->callback = callback;
+    timer->context = context;
+}
+
+void TimerWheel_Start(TimerWheelTimer_t *timer, TickType_t delayTicks)
+{
+    taskENTER_CRITICAL();
+    TimerWheel_StartLocked(timer, delayTicks);
+    taskEXIT_CRITICAL();
+}
+
+void TimerWheel_StartFromISR(TimerWheelTimer_t *timer, TickType_t delayTicks)
+{
+    UBaseType_t uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+    TimerWheel_StartLocked(timer, delayTicks);
+    taskEXIT_CRITICAL_FROM_ISR(uxSavedInterruptStatus);
+}
+
+BaseType_t TimerWheel_Stop(TimerWheelTimer_t *timer)
+{
+    BaseType_t xWasActive;
+
+    taskENTER_CRITICAL();
+    xWasActive = (timer->pprev != NULL) ? pdTRUE : pdFALSE;
+    if (xWasActive)
+    {
+        TimerWheel_Unlink(timer);
+    }
+    taskEXIT_CRITICAL();
+    return xWasActive;
+}
+
+TickType_t TimerWheel_Remaining(const TimerWheelTimer_t *timer)
+{
+    TickType_t remaining = 0;
+
+    taskENTER_CRITICAL();
+    if (timer->pprev != NULL)
+    {
+        remaining = timer->expiry - wheelTick;
+    }
+    taskEXIT_CRITICAL();
+    return remaining;
+}
+
+void TimerWheel_TickFromISR(BaseType_t *pxHigherPriorityTaskWoken)
+{
+    UBaseType_t uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+    TimerWheelTimer_t *due;
+    uint32_t level;
+
+    wheelTick++;
+
+    // 1. At the start of each level-0 round, bring the next block of the upper levels down
+    if ((wheelTick & L0_MASK) == 0)
+    {
+        for (level = 1; level < TIMER_WHEEL_LEVELS; ++level)
+        {
+            uint32_t index = (wheelTick >> LEVEL_SHIFT(level)) & LN_MASK;
+
+            TimerWheel_Cascade(&upperLevels[level - 1U][index]);
+            if (index != 0)
+            {
+                break; // The level above only turns when this one wraps
+            }
+        }
+    }
+
+    // 2. Everything in the current level-0 slot is due now
+    due = level0[wheelTick & L0_MASK];
+    level0[wheelTick & L0_MASK] = NULL;
+    while (due != NULL)
+    {
+        TimerWheelTimer_t *timer = due;
+
+        due = timer->next; // The callback may reuse the link
+        timer->pprev = NULL;
+        timer->callback(timer, pxHigherPriorityTaskWoken);
+    }
+
+    taskEXIT_CRITICAL_FROM_ISR(uxSavedInterruptStatus);
+}
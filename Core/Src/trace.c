@@ -0,0 +1,227 @@
+/**
+ * @file trace.c
+ * @brief Implementation of incident trace replay and recording.
+ *
+ * @date October 15, 2026
+ * @author shayb
+ */
+
+#include "trace.h"
+#include "logging.h"
+#include "task.h"
+#include "timers.h" // For xTimerPendFunctionCallFromISR
+
+#if defined(TRACE_HOST_BUILD)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#define TRACE_DUMP_WORDS_PER_LINE 8
+
+// --- Replay State ---
+static const uint32_t *replayRecords = NULL; // First record of the loaded image
+static uint32_t replayCount = 0;             // Records in the loaded image
+static uint32_t replayIndex = 0;             // Next record to inject
+static volatile uint8_t replayActive = 0;
+
+// --- Recorder State ---
+static uint32_t recordBuffer[TRACE_HEADER_WORDS + TRACE_RECORDER_CAPACITY];
+static uint32_t recordCount = 0;  // Records in the buffer, gap records included
+static uint32_t callCount = 0;    // Calls in the buffer
+static uint32_t droppedCalls = 0; // Calls that did not fit since the last dump
+static uint32_t lastRecordUs = 0;
+static uint8_t recordRestart = 0; // Next call starts a new recording (delay 0)
+static volatile uint8_t recorderEnabled = 1;
+
+// --- Private Functions ---
+
+/**
+ * @brief Timer service task callback for TraceRecorder_RequestDumpFromISR().
+ */
+static void TraceRecorder_DumpPended(void *pvParameter1, uint32_t ulParameter2)
+{
+    (void)pvParameter1;
+    (void)ulParameter2;
+    TraceRecorder_Dump();
+}
+
+// --- Public Functions: Replay ---
+
+BaseType_t TraceReplay_Load(const uint32_t *image, size_t lengthBytes)
+{
+    size_t words = lengthBytes / sizeof(uint32_t);
+
+    if (image == NULL || words < TRACE_HEADER_WORDS ||
+        image[0] != TRACE_MAGIC || image[1] != TRACE_VERSION ||
+        image[2] == 0 || image[2] > words - TRACE_HEADER_WORDS)
+    {
+        return pdFAIL;
+    }
+
+    taskENTER_CRITICAL();
+    replayRecords = &image[TRACE_HEADER_WORDS];
+    replayCount = image[2];
+    replayIndex = 0;
+    replayActive = 1;
+    taskEXIT_CRITICAL();
+    return pdPASS;
+}
+
+#if defined(TRACE_HOST_BUILD)
+BaseType_t TraceReplay_LoadFile(const char *path)
+{
+    struct stat st;
+    void *image;
+    int fd = open(path, O_RDONLY);
+
+    if (fd < 0)
+    {
+        return pdFAIL;
+    }
+    if (fstat(fd, &st) != 0 || st.st_size <= 0)
+    {
+        close(fd);
+        return pdFAIL;
+    }
+    image = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd); // The mapping stays valid after the descriptor is closed
+    if (image == MAP_FAILED)
+    {
+        return pdFAIL;
+    }
+    if (TraceReplay_Load((const uint32_t *)image, (size_t)st.st_size) != pdPASS)
+    {
+        munmap(image, (size_t)st.st_size);
+        return pdFAIL;
+    }
+    return pdPASS;
+}
+#endif
+
+BaseType_t TraceReplay_IsActive(void)
+{
+    return replayActive ? pdTRUE : pdFALSE;
+}
+
+BaseType_t TraceReplay_NextFromISR(uint32_t *delayUs, uint8_t *eventCode, uint8_t *severity)
+{
+    uint32_t accumulatedUs = 0;
+    uint32_t word;
+
+    while (replayActive)
+    {
+        if (replayIndex >= replayCount)
+        {
+#if TRACE_REPLAY_LOOP
+            replayIndex = 0; // Start the storm over
+#else
+            replayActive = 0;
+            break;
+#endif
+        }
+
+        word = replayRecords[replayIndex++];
+        accumulatedUs += TRACE_RECORD_DELAY_US(word);
+        if (TRACE_RECORD_CODE(word) != 0)
+        {
+            *delayUs = accumulatedUs;
+            *eventCode = (uint8_t)TRACE_RECORD_CODE(word);
+            *severity = (uint8_t)TRACE_RECORD_SEVERITY(word);
+            return pdPASS;
+        }
+        // Gap record: only extends the delay
+    }
+    return pdFAIL;
+}
+
+// --- Public Functions: Recorder ---
+
+void TraceRecorder_RecordFromISR(uint32_t nowUs, uint8_t eventCode, uint8_t severity)
+{
+    uint32_t *records = &recordBuffer[TRACE_HEADER_WORDS];
+    uint32_t deltaUs, gaps;
+
+    if (!recorderEnabled)
+    {
+        return;
+    }
+    if (recordRestart)
+    {
+        lastRecordUs = nowUs; // First call after a dump
+        recordRestart = 0;
+    }
+
+    // Delays longer than one record can hold become gap records; a call that
+    // does not fit together with its gaps is dropped whole
+    deltaUs = nowUs - lastRecordUs;
+    gaps = (deltaUs > TRACE_MAX_DELAY_US) ? (deltaUs - 1U) / TRACE_MAX_DELAY_US : 0;
+    if (gaps + 1U > TRACE_RECORDER_CAPACITY - recordCount)
+    {
+        droppedCalls++;
+        return;
+    }
+
+    for (; gaps > 0; --gaps)
+    {
+        records[recordCount++] = TRACE_RECORD(TRACE_MAX_DELAY_US, 0, 0);
+        deltaUs -= TRACE_MAX_DELAY_US;
+    }
+    records[recordCount++] = TRACE_RECORD(deltaUs, eventCode, severity);
+    callCount++;
+    lastRecordUs = nowUs;
+}
+
+void TraceRecorder_Dump(void)
+{
+    uint32_t total, calls, dropped, i;
+
+    // Freeze the buffer while it is printed
+    taskENTER_CRITICAL();
+    recorderEnabled = 0;
+    calls = callCount;
+    dropped = droppedCalls;
+    taskEXIT_CRITICAL();
+
+    recordBuffer[0] = TRACE_MAGIC;
+    recordBuffer[1] = TRACE_VERSION;
+    recordBuffer[2] = recordCount;
+    total = TRACE_HEADER_WORDS + recordCount;
+
+    LogInfo("--- Trace (%lu calls, %lu records, %lu words) ---\r\n", calls, recordCount, total);
+    if (dropped > 0)
+    {
+        LogWarn("Trace buffer full: %lu calls not recorded, raise TRACE_RECORDER_CAPACITY\r\n", dropped);
+    }
+    for (i = 0; i < total; i += TRACE_DUMP_WORDS_PER_LINE)
+    {
+        uint32_t w[TRACE_DUMP_WORDS_PER_LINE] = {0};
+        uint32_t n = (total - i < TRACE_DUMP_WORDS_PER_LINE) ? (total - i) : TRACE_DUMP_WORDS_PER_LINE;
+        uint32_t j;
+
+        for (j = 0; j < n; ++j)
+        {
+            w[j] = recordBuffer[i + j];
+        }
+        LogInfo("TRACE %04lx: %08lx %08lx %08lx %08lx %08lx %08lx %08lx %08lx\r\n",
+                i, w[0], w[1], w[2], w[3], w[4], w[5], w[6], w[7]);
+    }
+
+    taskENTER_CRITICAL();
+    recordCount = 0;
+    callCount = 0;
+    droppedCalls = 0;
+    recordRestart = 1;
+    recorderEnabled = 1;
+    taskEXIT_CRITICAL();
+}
+
+void TraceRecorder_RequestDumpFromISR(BaseType_t *pxHigherPriorityTaskWoken)
+{
+    if (xTaskGetSchedulerState() == taskSCHEDULER_NOT_STARTED)
+    {
+        return; // Timer command queue does not exist yet
+    }
+    (void)xTimerPendFunctionCallFromISR(TraceRecorder_DumpPended, NULL, 0, pxHigherPriorityTaskWoken);
+}
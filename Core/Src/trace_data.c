@@ -0,0 +1,60 @@
+/**
+ * @file trace_data.c
+ * @brief Flash-resident incident trace replayed when TRACE_REPLAY_ENABLE is set.
+ *
+ * The default trace is a short synthetic storm: quiet background calls, a
+ * structure fire followed by a burst of casualty calls, a long lull and the
+ * aftermath. Replace STORM_RECORDS with the words of a TraceRecorder_Dump()
+ * capture (records only, without the three header words) to replay a live run.
+ *
+ * @date October 15, 2026
+ * @author shayb
+ */
+
+#include "trace.h"
+
+// Delays are in microseconds since the previous record
+#define STORM_RECORDS \
+    /* Quiet background */ \
+    TRACE_RECORD(2826000, EVENT_CODE_POLICE, EVENT_SEVERITY_HIGH), \
+    TRACE_RECORD(4166000, EVENT_CODE_AMBULANCE, EVENT_SEVERITY_LOW), \
+    TRACE_RECORD(3694000, EVENT_CODE_POLICE, EVENT_SEVERITY_MEDIUM), \
+    TRACE_RECORD(3887000, EVENT_CODE_POLICE, EVENT_SEVERITY_MEDIUM), \
+    TRACE_RECORD(1653000, EVENT_CODE_FIRE_DEPT, EVENT_SEVERITY_MEDIUM), \
+    TRACE_RECORD(3212000, EVENT_CODE_POLICE, EVENT_SEVERITY_MEDIUM), \
+    /* Structure fire reported, then a wave of casualty and traffic calls */ \
+    TRACE_RECORD(800000, EVENT_CODE_FIRE_DEPT, EVENT_SEVERITY_CRITICAL), \
+    TRACE_RECORD(342000, EVENT_CODE_AMBULANCE, EVENT_SEVERITY_MEDIUM), \
+    TRACE_RECORD(349000, EVENT_CODE_AMBULANCE, EVENT_SEVERITY_HIGH), \
+    TRACE_RECORD(382000, EVENT_CODE_AMBULANCE, EVENT_SEVERITY_HIGH), \
+    TRACE_RECORD(359000, EVENT_CODE_FIRE_DEPT, EVENT_SEVERITY_MEDIUM), \
+    TRACE_RECORD(173000, EVENT_CODE_AMBULANCE, EVENT_SEVERITY_HIGH), \
+    TRACE_RECORD(128000, EVENT_CODE_FIRE_DEPT, EVENT_SEVERITY_CRITICAL), \
+    TRACE_RECORD(133000, EVENT_CODE_POLICE, EVENT_SEVERITY_HIGH), \
+    TRACE_RECORD(217000, EVENT_CODE_FIRE_DEPT, EVENT_SEVERITY_CRITICAL), \
+    TRACE_RECORD(357000, EVENT_CODE_AMBULANCE, EVENT_SEVERITY_CRITICAL), \
+    TRACE_RECORD(109000, EVENT_CODE_AMBULANCE, EVENT_SEVERITY_HIGH), \
+    TRACE_RECORD(90000, EVENT_CODE_FIRE_DEPT, EVENT_SEVERITY_CRITICAL), \
+    TRACE_RECORD(332000, EVENT_CODE_POLICE, EVENT_SEVERITY_MEDIUM), \
+    TRACE_RECORD(298000, EVENT_CODE_AMBULANCE, EVENT_SEVERITY_MEDIUM), \
+    TRACE_RECORD(213000, EVENT_CODE_AMBULANCE, EVENT_SEVERITY_CRITICAL), \
+    TRACE_RECORD(184000, EVENT_CODE_AMBULANCE, EVENT_SEVERITY_HIGH), \
+    TRACE_RECORD(213000, EVENT_CODE_FIRE_DEPT, EVENT_SEVERITY_MEDIUM), \
+    TRACE_RECORD(289000, EVENT_CODE_AMBULANCE, EVENT_SEVERITY_CRITICAL), \
+    TRACE_RECORD(97000, EVENT_CODE_FIRE_DEPT, EVENT_SEVERITY_HIGH), \
+    /* Gap record: ~67 s lull */ \
+    TRACE_RECORD(TRACE_MAX_DELAY_US, 0, 0), \
+    /* Aftermath */ \
+    TRACE_RECORD(4096000, EVENT_CODE_AMBULANCE, EVENT_SEVERITY_LOW), \
+    TRACE_RECORD(3401000, EVENT_CODE_POLICE, EVENT_SEVERITY_MEDIUM), \
+    TRACE_RECORD(3727000, EVENT_CODE_POLICE, EVENT_SEVERITY_LOW), \
+    TRACE_RECORD(4285000, EVENT_CODE_FIRE_DEPT, EVENT_SEVERITY_MEDIUM)
+
+const uint32_t traceFlashImage[] = {
+    TRACE_MAGIC,
+    TRACE_VERSION,
+    sizeof((uint32_t[]){STORM_RECORDS}) / sizeof(uint32_t), // Record count
+    STORM_RECORDS,
+};
+
+const size_t traceFlashImageWords = sizeof(traceFlashImage) / sizeof(traceFlashImage[0]);
@@ -0,0 +1,182 @@
+/**
+ * @file unit_lifecycle.c
+ * @brief Per-department phase distributions and mission planning.
+ *
+ * On-scene time comes from the department's service-time model
+ * (GetRandomTaskDurationTicks), less any work done before a pre-emption. The other phases are uniform between the
+ * bounds in phaseProfiles[], and transport happens on a fraction of the calls.
+ * All lengths are simulated time; they are converted to wall-clock ticks for
+ * the timing wheel once, when the mission is planned.
+ *
+ * @date October 15, 2026
+ * @author shayb
+ */
+
+#include "unit_lifecycle.h"
+#include "resource_task.h" // For GetRandomTaskDurationTicks
+#include "rng_service.h"
+#include "time_base.h"
+
+/**
+ * @brief Uniform phase length, in simulated milliseconds.
+ */
+typedef struct
+{
+    uint16_t minMs;
+    uint16_t maxMs;
+} PhaseRange_t;
+
+/**
+ * @brief Phase distributions of one department.
+ */
+typedef struct
+{
+    PhaseRange_t turnout;    // DISPATCHED
+    PhaseRange_t travel;     // EN_ROUTE
+    PhaseRange_t transport;  // TRANSPORTING
+    PhaseRange_t returnTrip; // RETURNING
+    uint8_t transportP256;   // Chance (x/256) that a call needs transport
+} UnitPhaseProfile_t;
+
+// --- Phase Profiles (same time scale as the service-time tables) ---
+
+static const UnitPhaseProfile_t phaseProfiles[DEPT_COUNT] = {
+    [DEPT_POLICE] = {{20, 60}, {150, 600}, {300, 900}, {150, 600}, 40},       // Arrests only
+    [DEPT_AMBULANCE] = {{60, 120}, {250, 900}, {400, 1400}, {250, 900}, 200}, // Most patients go to hospital
+    [DEPT_FIRE] = {{80, 160}, {300, 1000}, {0, 0}, {300, 1000}, 0},           // Never transports
+};
+
+static const char *const phaseNames[UNIT_PHASE_COUNT] = {
+    [UNIT_PHASE_AVAILABLE] = "available",
+    [UNIT_PHASE_DISPATCHED] = "dispatched",
+    [UNIT_PHASE_EN_ROUTE] = "en route",
+    [UNIT_PHASE_ON_SCENE] = "on scene",
+    [UNIT_PHASE_TRANSPORTING] = "transporting",
+    [UNIT_PHASE_RETURNING] = "returning",
+};
+
+// --- Private Functions ---
+
+/**
+ * @brief Draws a uniform phase length in simulated ticks.
+ */
+static uint32_t UnitLifecycle_DrawTicks(const PhaseRange_t *range)
+{
+    uint32_t ms = range->minMs;
+
+    if (range->maxMs > range->minMs)
+    {
+        ms += RngService_Next() % (uint32_t)(range->maxMs - range->minMs + 1U);
+    }
+    return TimeBase_MsToTicks(ms);
+}
+
+/**
+ * @brief Converts a mission's simulated phase lengths to wall-clock ticks.
+ *
+ * Phase ends are rounded to the nearest wall tick from the start of the
+ * mission, not each phase on its own: rounding every phase up lengthens a
+ * mission by about half a tick per phase, i.e. half the dilation factor in
+ * simulated ms, which pushes the departments' load up by several percent at
+ * 60x. Rounded this way a mission is off by at most half a tick and by nothing
+ * on average when it starts on a tick, as a call taken from the queue does.
+ * A call that finds an idle unit starts part-way into a tick and loses that
+ * part, which only happens below saturation. test/host/test_time_dilation.c
+ * compares the queues at 1x and dilated. A phase that is not skipped still
+ * gets at least one tick; the phases after it make up for it.
+ */
+static void UnitLifecycle_ToWall(const uint32_t simTicks[UNIT_PHASE_COUNT], UnitMission_t *mission)
+{
+    const uint32_t factor = TimeBase_GetDilation(); // Once, in case it changes meanwhile
+    uint64_t simEnd = 0;
+    uint32_t wallEnd = 0, wallTicks;
+    uint8_t phase;
+
+    for (phase = 0; phase < UNIT_PHASE_COUNT; ++phase)
+    {
+        if (simTicks[phase] == 0)
+        {
+            mission->phaseTicks[phase] = 0;
+            continue;
+        }
+        simEnd += simTicks[phase];
+        wallTicks = (uint32_t)((simEnd + (factor / 2U)) / factor);
+        wallTicks = (wallTicks > wallEnd) ? wallTicks - wallEnd : 1U;
+        wallTicks = (wallTicks > UINT16_MAX) ? UINT16_MAX : wallTicks;
+        mission->phaseTicks[phase] = (uint16_t)wallTicks;
+        wallEnd += wallTicks;
+    }
+}
+
+// --- Public Functions ---
+
+uint32_t UnitLifecycle_PlanMission(uint8_t department, EmergencyEvent_t *event, UnitMission_t *mission)
+{
+    const UnitPhaseProfile_t *profile = &phaseProfiles[department];
+    uint32_t simTicks[UNIT_PHASE_COUNT] = {0};
+    uint32_t busyTicks = 0;
+    uint8_t phase;
+
+    configASSERT(department < DEPT_COUNT);
+
+    simTicks[UNIT_PHASE_DISPATCHED] = UnitLifecycle_DrawTicks(&profile->turnout);
+    simTicks[UNIT_PHASE_EN_ROUTE] = UnitLifecycle_DrawTicks(&profile->travel);
+    if (event->sceneUs == 0)
+    {
+        simTicks[UNIT_PHASE_ON_SCENE] = GetRandomTaskDurationTicks(department);
+        event->sceneUs = (uint32_t)TimeBase_TicksToUs(simTicks[UNIT_PHASE_ON_SCENE]);
+    }
+    else
+    {
+        simTicks[UNIT_PHASE_ON_SCENE] = TimeBase_UsToTicks(event->sceneUs - event->sceneDoneUs); // Resumed call
+    }
+    if ((RngService_Next() & 0xFFU) < profile->transportP256)
+    {
+        simTicks[UNIT_PHASE_TRANSPORTING] = UnitLifecycle_DrawTicks(&profile->transport);
+    }
+    simTicks[UNIT_PHASE_RETURNING] = UnitLifecycle_DrawTicks(&profile->returnTrip);
+
+    UnitLifecycle_ToWall(simTicks, mission);
+    for (phase = 0; phase < UNIT_PHASE_COUNT; ++phase)
+    {
+        if (UnitLifecycle_IsBusy((UnitPhase_t)phase))
+        {
+            busyTicks += simTicks[phase];
+        }
+    }
+    if (mission->phaseTicks[UNIT_PHASE_RETURNING] == 0)
+    {
+        mission->phaseTicks[UNIT_PHASE_RETURNING] = 1; // Every mission ends with the way back
+    }
+    return busyTicks;
+}
+
+TickType_t UnitLifecycle_BusyTicks(const UnitMission_t *mission)
+{
+    TickType_t ticks = 0;
+    uint8_t phase;
+
+    for (phase = UNIT_PHASE_DISPATCHED; phase <= UNIT_PHASE_TRANSPORTING; ++phase)
+    {
+        ticks += mission->phaseTicks[phase];
+    }
+    return ticks;
+}
+
+UnitPhase_t UnitLifecycle_NextPhase(const UnitMission_t *mission, UnitPhase_t phase)
+{
+    if (phase == UNIT_PHASE_RETURNING)
+    {
+        return UNIT_PHASE_AVAILABLE;
+    }
+    do
+    {
+        phase = (UnitPhase_t)(phase + 1);
+    } while (phase < UNIT_PHASE_RETURNING && mission->phaseTicks[phase] == 0);
+    return phase;
+}
+
+const char *UnitLifecycle_PhaseName(uint8_t phase)
+{
+    return (phase < UNIT_PHASE_COUNT) ? phaseNames[phase] : "unknown";
+}
@@ -0,0 +1,268 @@
+/**
+ * @file utilization.c
+ * @brief Implementation of unit and department utilization accounting.
+ *
+ * A department's aggregate is a set of step functions (units in each phase)
+ * integrated over time: whenever one of its units changes phase, the areas
+ * since the previous change are added up before the counts move. The rolling
+ * window is a ring of per-window busy areas. Windows are closed lazily, on the
+ * next update or query after they end; after a long quiet gap every slot holds
+ * a full window of the same state, so the remaining whole windows are skipped
+ * in one step and an update never loops more than UTILIZATION_WINDOW_COUNT times.
+ *
+ * All updates run inside the kernel critical section, which is short and
+ * bounded.
+ *
+ * @date October 15, 2026
+ * @author shayb
+ */
+
+#include "utilization.h"
+#include "time_base.h"
+#include "routing_table.h" // For Routing_DeptName
+#include "logging.h"
+#include "task.h"
+
+#define WINDOW_US ((uint64_t)UTILIZATION_WINDOW_MS * TIME_US_PER_MS)
+
+_Static_assert(UTILIZATION_WINDOW_COUNT >= 2 && UTILIZATION_WINDOW_COUNT <= 255, "UTILIZATION_WINDOW_COUNT must be 2..255");
+
+/**
+ * @brief Aggregate of one department.
+ */
+typedef struct
+{
+    uint16_t numUnits;
+    uint16_t unitsInPhase[UNIT_PHASE_COUNT];
+    uint64_t phaseUs[UNIT_PHASE_COUNT];                // Lifetime unit-us in each phase
+    uint64_t windowBusyUs[UTILIZATION_WINDOW_COUNT];   // Busy unit-us per window (ring)
+    uint64_t windowUnitUs[UTILIZATION_WINDOW_COUNT];   // Registered unit-us per window (ring)
+    TimeStamp_t lastChangeUs;                          // Areas are accounted up to here
+    TimeStamp_t windowStartUs;                         // Start of the current window
+    uint8_t window;                                    // Current slot of the ring
+    uint8_t windowsClosed;                             // Full windows in the ring (at most COUNT - 1)
+} DeptUtil_t;
+
+static DeptUtil_t deptUtil[DEPT_COUNT];
+
+// --- Private Functions ---
+
+/**
+ * @brief Units of a department that are committed to a call.
+ */
+static inline uint32_t Utilization_BusyUnits(const DeptUtil_t *dept)
+{
+    return (uint32_t)dept->unitsInPhase[UNIT_PHASE_DISPATCHED] + dept->unitsInPhase[UNIT_PHASE_EN_ROUTE] +
+           dept->unitsInPhase[UNIT_PHASE_ON_SCENE] + dept->unitsInPhase[UNIT_PHASE_TRANSPORTING];
+}
+
+/**
+ * @brief Adds the areas from lastChangeUs to @p toUs (same window) at the current counts.
+ */
+static void Utilization_Accumulate(DeptUtil_t *dept, TimeStamp_t toUs)
+{
+    const uint64_t elapsedUs = toUs - dept->lastChangeUs;
+    uint8_t phase;
+
+    for (phase = 0; phase < UNIT_PHASE_COUNT; ++phase)
+    {
+        dept->phaseUs[phase] += dept->unitsInPhase[phase] * elapsedUs;
+    }
+    dept->windowBusyUs[dept->window] += Utilization_BusyUnits(dept) * elapsedUs;
+    dept->windowUnitUs[dept->window] += dept->numUnits * elapsedUs;
+    dept->lastChangeUs = toUs;
+}
+
+/**
+ * @brief Brings a department's areas up to @p nowUs, closing the windows that ended.
+ */
+static void Utilization_Advance(DeptUtil_t *dept, TimeStamp_t nowUs)
+{
+    uint8_t closed = 0;
+    uint8_t phase;
+
+    while ((nowUs - dept->windowStartUs) >= WINDOW_US)
+    {
+        Utilization_Accumulate(dept, dept->windowStartUs + WINDOW_US);
+        dept->windowStartUs += WINDOW_US;
+        dept->window = (uint8_t)((dept->window + 1U) % UTILIZATION_WINDOW_COUNT);
+        dept->windowBusyUs[dept->window] = 0;
+        dept->windowUnitUs[dept->window] = 0;
+        if (dept->windowsClosed < UTILIZATION_WINDOW_COUNT - 1U)
+        {
+            dept->windowsClosed++;
+        }
+
+        if (++closed == UTILIZATION_WINDOW_COUNT)
+        {
+            // Every other slot now holds a full window of the current counts: skipping
+            // more whole windows would not change the ring, only the lifetime areas
+            const uint64_t skipUs = ((nowUs - dept->windowStartUs) / WINDOW_US) * WINDOW_US;
+
+            for (phase = 0; phase < UNIT_PHASE_COUNT; ++phase)
+            {
+                dept->phaseUs[phase] += dept->unitsInPhase[phase] * skipUs;
+            }
+            dept->windowStartUs += skipUs;
+            dept->lastChangeUs = dept->windowStartUs;
+        }
+    }
+    Utilization_Accumulate(dept, nowUs);
+}
+
+/**
+ * @brief Credits the time since the unit's last change to its current phase.
+ */
+static void Utilization_Credit(UnitUtil_t *unit, TimeStamp_t nowUs)
+{
+    const uint64_t elapsedUs = (nowUs - unit->sinceUs) + unit->phaseRemUs[unit->phase];
+
+    unit->phaseMs[unit->phase] += (uint32_t)(elapsedUs / TIME_US_PER_MS);
+    unit->phaseRemUs[unit->phase] = (uint16_t)(elapsedUs % TIME_US_PER_MS);
+    unit->sinceUs = nowUs;
+}
+
+/**
+ * @brief Share in permille, 0 if the total is 0.
+ */
+static inline uint16_t Utilization_Permille(uint64_t part, uint64_t total)
+{
+    return (total > 0) ? (uint16_t)((part * 1000U) / total) : 0;
+}
+
+// --- Public Functions ---
+
+void Utilization_InitUnit(UnitUtil_t *unit, uint8_t department)
+{
+    DeptUtil_t *dept = &deptUtil[department];
+    uint8_t phase;
+
+    configASSERT(department < DEPT_COUNT);
+    for (phase = 0; phase < UNIT_PHASE_COUNT; ++phase)
+    {
+        unit->phaseMs[phase] = 0;
+        unit->phaseRemUs[phase] = 0;
+    }
+    unit->phase = UNIT_PHASE_AVAILABLE;
+    unit->department = department;
+
+    taskENTER_CRITICAL();
+    unit->sinceUs = TimeBase_SimNowUs();
+    if (dept->numUnits == 0)
+    {
+        dept->lastChangeUs = unit->sinceUs; // First unit: the department's accounting starts now
+        dept->windowStartUs = unit->sinceUs;
+    }
+    Utilization_Advance(dept, unit->sinceUs);
+    dept->numUnits++;
+    dept->unitsInPhase[UNIT_PHASE_AVAILABLE]++;
+    taskEXIT_CRITICAL();
+}
+
+void Utilization_Transition(UnitUtil_t *unit, UnitPhase_t phase)
+{
+    DeptUtil_t *dept = &deptUtil[unit->department];
+    TimeStamp_t nowUs;
+
+    if (unit->phase == (uint8_t)phase)
+    {
+        return;
+    }
+    taskENTER_CRITICAL();
+    nowUs = TimeBase_SimNowUs(); // Inside the section, so the department clock never goes back
+    Utilization_Advance(dept, nowUs);
+    Utilization_Credit(unit, nowUs);
+    dept->unitsInPhase[unit->phase]--;
+    dept->unitsInPhase[phase]++;
+    unit->phase = (uint8_t)phase;
+    taskEXIT_CRITICAL();
+}
+
+void Utilization_GetUnit(const UnitUtil_t *unit, UnitUtilization_t *out)
+{
+    UnitUtil_t copy;
+    uint8_t phase;
+
+    taskENTER_CRITICAL();
+    copy = *unit;
+    Utilization_Credit(&copy, TimeBase_SimNowUs());
+    taskEXIT_CRITICAL();
+
+    out->busyMs = 0;
+    out->totalMs = 0;
+    for (phase = 0; phase < UNIT_PHASE_COUNT; ++phase)
+    {
+        out->phaseMs[phase] = copy.phaseMs[phase];
+        out->totalMs += copy.phaseMs[phase];
+        if (UnitLifecycle_IsBusy((UnitPhase_t)phase))
+        {
+            out->busyMs += copy.phaseMs[phase];
+        }
+    }
+    out->busyPermille = Utilization_Permille(out->busyMs, out->totalMs);
+    out->phase = copy.phase;
+}
+
+void Utilization_GetDept(uint8_t department, DeptUtilization_t *out)
+{
+    DeptUtil_t *dept = &deptUtil[department];
+    uint64_t busyUs = 0, unitUs = 0, lifetimeUs = 0;
+    uint8_t i;
+
+    configASSERT(department < DEPT_COUNT);
+
+    taskENTER_CRITICAL();
+    if (dept->numUnits > 0)
+    {
+        Utilization_Advance(dept, TimeBase_SimNowUs());
+    }
+    for (i = 0; i < UTILIZATION_WINDOW_COUNT; ++i)
+    {
+        busyUs += dept->windowBusyUs[i];
+        unitUs += dept->windowUnitUs[i];
+    }
+    for (i = 0; i < UNIT_PHASE_COUNT; ++i)
+    {
+        out->unitsInPhase[i] = dept->unitsInPhase[i];
+        lifetimeUs += dept->phaseUs[i];
+    }
+    for (i = 0; i < UNIT_PHASE_COUNT; ++i)
+    {
+        out->phasePermille[i] = Utilization_Permille(dept->phaseUs[i], lifetimeUs);
+    }
+    out->numUnits = dept->numUnits;
+    out->busyUnits = (uint16_t)Utilization_BusyUnits(dept);
+    out->rollingSpanMs = dept->windowsClosed * UTILIZATION_WINDOW_MS +
+                         (uint32_t)((dept->lastChangeUs - dept->windowStartUs) / TIME_US_PER_MS);
+    taskEXIT_CRITICAL();
+
+    out->rollingBusyPermille = Utilization_Permille(busyUs, unitUs);
+}
+
+void Utilization_Dump(void)
+{
+    DeptUtilization_t util;
+    uint8_t dept;
+
+    for (dept = 0; dept < DEPT_COUNT; ++dept)
+    {
+        Utilization_GetDept(dept, &util);
+        if (util.numUnits == 0)
+        {
+            continue;
+        }
+        LogInfo("%s utilization: %u/%u units busy, %u.%u%% busy over %lu s\r\n",
+                Routing_DeptName(dept), util.busyUnits, util.numUnits,
+                util.rollingBusyPermille / 10U, util.rollingBusyPermille % 10U, util.rollingSpanMs / 1000U);
+        LogInfo("%s unit-time: available %u%%, dispatched %u%%, en route %u%%, on scene %u%%, transporting %u%%, returning %u%%\r\n",
+                Routing_DeptName(dept), util.phasePermille[UNIT_PHASE_AVAILABLE] / 10U,
+                util.phasePermille[UNIT_PHASE_DISPATCHED] / 10U, util.phasePermille[UNIT_PHASE_EN_ROUTE] / 10U,
+                util.phasePermille[UNIT_PHASE_ON_SCENE] / 10U, util.phasePermille[UNIT_PHASE_TRANSPORTING] / 10U,
+                util.phasePermille[UNIT_PHASE_RETURNING] / 10U);
+        if (util.rollingBusyPermille >= UTILIZATION_SATURATION_PCT * 10U)
+        {
+            LogWarn("%s is saturating: units busy %u.%u%% of the time, add units or expect its queue to grow\r\n",
+                    Routing_DeptName(dept), util.rollingBusyPermille / 10U, util.rollingBusyPermille % 10U);
+        }
+    }
+}
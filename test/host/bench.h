@@ -0,0 +1,62 @@
+/**
+ * @file bench.h
+ * @brief Timing and random helpers shared by the host benchmarks (test/host).
+ *
+ * @date October 16, 2026
+ * @author shayb
+ */
+
+#ifndef TEST_HOST_BENCH_H_
+#define TEST_HOST_BENCH_H_
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+/**
+ * @brief Monotonic time in nanoseconds.
+ */
+static inline uint64_t Bench_NowNs(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+/**
+ * @brief splitmix64: fixed-seed generator, so every run sees the same sequence.
+ */
+static inline uint64_t Bench_Random(uint64_t *state)
+{
+    uint64_t z = (*state += 0x9E3779B97F4A7C15ULL);
+
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+/**
+ * @brief Uniform value in [0, bound).
+ */
+static inline uint32_t Bench_RandomBelow(uint64_t *state, uint32_t bound)
+{
+    return (uint32_t)(((Bench_Random(state) >> 32) * bound) >> 32);
+}
+
+/**
+ * @brief Fails the test with a message when a check does not hold.
+ */
+#define BENCH_CHECK(cond, ...)                       \
+    do                                               \
+    {                                                \
+        if (!(cond))                                 \
+        {                                            \
+            fprintf(stderr, "FAILED: " __VA_ARGS__); \
+            fprintf(stderr, "\n");                   \
+            exit(1);                                 \
+        }                                            \
+    } while (0)
+
+#endif /* TEST_HOST_BENCH_H_ */
@@ -0,0 +1,236 @@
+/**
+ * @file bench_dispatcher_modes.c
+ * @brief Host benchmark: dispatcher wake-up path in task mode against deferred mode (dispatcher.c).
+ *
+ * The producer side posts a burst of handles to the input ring as
+ * Dispatcher_PostFromISR does; the consumer side wakes and drains it, for
+ * several burst sizes. Only the wake-up differs between the modes:
+ *
+ *   - task:     xTaskNotifyFromISR(eSetBits) on the empty -> non-empty
+ *               transition; Dispatcher_Task returns from xTaskNotifyWait
+ *               and drains;
+ *   - deferred: xTimerPendFunctionCallFromISR on the same transition, i.e.
+ *               one DaemonTaskMessage_t posted to the timer command queue;
+ *               the timer service task takes it in one loop iteration
+ *               (scheduler suspended while it samples the tick count, then
+ *               xQueueReceive until the queue is empty) and calls
+ *               Dispatcher_DeferredWork, which drains.
+ *
+ * The timer task is modelled on its kernel calls, as in bench_timer_wheel.
+ * The context switch is not counted: both modes switch once per wake-up, to
+ * the dispatcher task or to the timer service task, so on the target the
+ * modes differ by the kernel path measured here and by the stack of the task
+ * deferred mode saves. Routing is left out too: it is the same code in both.
+ * Each figure is the best of RUNS runs.
+ *
+ * @date October 16, 2026
+ * @author shayb
+ */
+
+#include "bench.h"
+#include "spsc_ring.h"
+#include "queue.h"
+#include "task.h"
+#include "timers.h" // For PendedFunction_t
+
+#define RING_LENGTH 32U
+#define ITEMS_PER_BURST_SIZE 2000000U
+#define TIMER_QUEUE_LENGTH 10U // configTIMER_QUEUE_LENGTH of the firmware
+#define RUNS 5U                 // Best of, against the noise of a desktop OS
+
+static const uint32_t burstSizes[] = {1, 4, 8, 32};
+
+/**
+ * @brief Pended function call as posted by xTimerPendFunctionCallFromISR (DaemonTaskMessage_t).
+ */
+typedef struct
+{
+    BaseType_t xMessageID;
+    PendedFunction_t pxCallbackFunction;
+    void *pvParameter1;
+    uint32_t ulParameter2;
+} PendMessage_t;
+
+/**
+ * @brief Cost of one mode at one burst size.
+ */
+typedef struct
+{
+    uint64_t ns;
+    uint32_t wakeups;
+} Result_t;
+
+static EventHandle_t ringStorage[RING_LENGTH];
+static SpscRing_t ring;
+static TaskHandle_t consumerTask;
+static QueueHandle_t timerQueue;
+static EventHandle_t expected;
+static uint8_t pendFailed;
+
+// --- Consumer ---
+
+static void Bench_Drain(void)
+{
+    EventHandle_t handle;
+
+    while (SpscRing_Pop(&ring, &handle) == pdPASS)
+    {
+        BENCH_CHECK(handle == expected, "order: got %u, expected %u", handle, expected);
+        expected++;
+    }
+}
+
+static void Bench_DeferredWork(void *pvParameter1, uint32_t ulParameter2)
+{
+    (void)pvParameter1;
+    (void)ulParameter2;
+    Bench_Drain();
+}
+
+/**
+ * @brief Dispatcher_Task: woken by its notification, drains.
+ */
+static BaseType_t Task_Wake(void)
+{
+    uint32_t notifiedBits = 0;
+
+    if (xTaskNotifyWait(0, 0xFFFFFFFFUL, &notifiedBits, 0) != pdPASS)
+    {
+        return pdFALSE;
+    }
+    Bench_Drain();
+    return pdTRUE;
+}
+
+/**
+ * @brief One iteration of the timer service task with a pended call waiting.
+ */
+static BaseType_t Deferred_Wake(void)
+{
+    PendMessage_t message;
+    BaseType_t woken = pdFALSE;
+
+    // prvProcessTimerOrBlockTask: no active timer, sample the time, nothing expired
+    vTaskSuspendAll();
+    (void)xTaskGetTickCount();
+    (void)xTaskResumeAll();
+
+    // prvProcessReceivedCommands: every queued command, until the queue is empty
+    while (xQueueReceive(timerQueue, &message, 0) == pdPASS)
+    {
+        BENCH_CHECK(message.xMessageID < 0, "timer command instead of a pended call");
+        message.pxCallbackFunction(message.pvParameter1, message.ulParameter2);
+        woken = pdTRUE;
+    }
+    return woken;
+}
+
+// --- Producer ---
+
+static void Task_Post(EventHandle_t handle, uint32_t *wakeups)
+{
+    BaseType_t wasEmpty, woken = pdFALSE;
+
+    BENCH_CHECK(SpscRing_Push(&ring, handle, &wasEmpty) == pdPASS, "ring push");
+    if (wasEmpty)
+    {
+        xTaskNotifyFromISR(consumerTask, 1UL, eSetBits, &woken);
+        (*wakeups)++;
+    }
+}
+
+static void Deferred_Post(EventHandle_t handle, uint32_t *wakeups)
+{
+    BaseType_t wasEmpty, woken = pdFALSE;
+
+    BENCH_CHECK(SpscRing_Push(&ring, handle, &wasEmpty) == pdPASS, "ring push");
+    if (wasEmpty || pendFailed)
+    {
+        const PendMessage_t message = {-1, Bench_DeferredWork, NULL, 0};
+
+        pendFailed = (xQueueSendFromISR(timerQueue, &message, &woken) != pdPASS);
+        (*wakeups)++;
+    }
+}
+
+/**
+ * @brief One wake-up path under test.
+ */
+typedef struct
+{
+    const char *name;
+    void (*post)(EventHandle_t handle, uint32_t *wakeups);
+    BaseType_t (*wake)(void);
+} Mode_t;
+
+static void Bench_Run(const Mode_t *mode, uint32_t burst, Result_t *result)
+{
+    const uint32_t bursts = ITEMS_PER_BURST_SIZE / burst;
+    EventHandle_t next = 0;
+    uint32_t b, i;
+    uint64_t start;
+
+    *result = (Result_t){0};
+    expected = 0;
+    start = Bench_NowNs();
+    for (b = 0; b < bursts; ++b)
+    {
+        for (i = 0; i < burst; ++i)
+        {
+            mode->post(next++, &result->wakeups);
+        }
+        BENCH_CHECK(mode->wake() == pdTRUE, "%s: consumer not woken", mode->name);
+    }
+    result->ns = Bench_NowNs() - start;
+    BENCH_CHECK(expected == next, "%s: %u handles drained, %u posted", mode->name, expected, next);
+}
+
+static void Bench_Idle(void *pvParameters)
+{
+    (void)pvParameters;
+}
+
+int main(void)
+{
+    static const Mode_t modes[] = {
+        {"task", Task_Post, Task_Wake},
+        {"deferred", Deferred_Post, Deferred_Wake},
+    };
+    Result_t r[sizeof(modes) / sizeof(modes[0])];
+    size_t b, m;
+
+    // Never runs: only its notification state is used, as the current task
+    BENCH_CHECK(xTaskCreate(Bench_Idle, "Dispatcher", configMINIMAL_STACK_SIZE, NULL, 1, &consumerTask) == pdPASS, "task creation");
+    timerQueue = xQueueCreate(TIMER_QUEUE_LENGTH, sizeof(PendMessage_t));
+    BENCH_CHECK(timerQueue != NULL, "queue creation");
+    BENCH_CHECK(SpscRing_Init(&ring, ringStorage, RING_LENGTH) == pdPASS, "ring init");
+
+    printf("Bursts posted to the input ring, one consumer wake-up each, %u items per burst size\n\n", ITEMS_PER_BURST_SIZE);
+    printf("%6s | %-22s | %-22s | %9s\n", "", "task mode", "deferred mode", "");
+    printf("%6s | %10s %11s | %10s %11s | %9s\n", "burst", "ns/item", "wake-ups", "ns/item", "wake-ups", "ns/wake");
+
+    for (b = 0; b < sizeof(burstSizes) / sizeof(burstSizes[0]); ++b)
+    {
+        for (m = 0; m < sizeof(modes) / sizeof(modes[0]); ++m)
+        {
+            Result_t run;
+            uint32_t i;
+
+            r[m].ns = UINT64_MAX;
+            for (i = 0; i < RUNS; ++i)
+            {
+                Bench_Run(&modes[m], burstSizes[b], &run);
+                r[m] = (run.ns < r[m].ns) ? run : r[m];
+            }
+        }
+        // Extra cost of deferred mode per wake-up (negative: cheaper)
+        printf("%6u | %10.1f %11u | %10.1f %11u | %+9.1f\n", burstSizes[b],
+               (double)r[0].ns / ITEMS_PER_BURST_SIZE, r[0].wakeups,
+               (double)r[1].ns / ITEMS_PER_BURST_SIZE, r[1].wakeups,
+               ((double)r[1].ns - (double)r[0].ns) / r[0].wakeups);
+
+        BENCH_CHECK(r[0].wakeups == r[1].wakeups && r[0].wakeups == ITEMS_PER_BURST_SIZE / burstSizes[b],
+                    "wake-ups differ: task %u, deferred %u", r[0].wakeups, r[1].wakeups);
+    }
+    return 0;
+}
@@ -0,0 +1,151 @@
+/**
+ * @file bench_prio_queue.c
+ * @brief Host benchmark: queueing delay of a critical call vs. backlog (prio_queue.c).
+ *
+ * For a growing backlog of LOW..HIGH calls, a CRITICAL call is posted and the
+ * queue is drained until it comes out. The number of calls served before it is
+ * its queueing delay in service times. The same run on a FreeRTOS FIFO queue
+ * (the former xDispatcherQueue) shows the delay the priority queue removes.
+ * Both queues also report the cost of one send + receive at each backlog.
+ *
+ * Fails if a critical call ever waits behind a less severe one.
+ *
+ * @date October 16, 2026
+ * @author shayb
+ */
+
+#include "bench.h"
+#include "prio_queue.h"
+#include "queue.h"
+#include "project_config.h" // For the severity levels
+
+#define ROUNDS 200
+#define PAIRS_PER_ROUND 64
+#define QUEUE_LENGTH PRIO_QUEUE_MAX_LENGTH
+#define CRITICAL_TAG 0xFFFFU // Item value of the probe call
+
+static const uint32_t backlogs[] = {0, 8, 32, 64, 128, 192, QUEUE_LENGTH - 1};
+
+/**
+ * @brief Worst case of one queue at one backlog.
+ */
+typedef struct
+{
+    uint32_t maxAhead; // Calls served before the critical one
+    uint64_t probeNs;  // Send + receive of the critical call, summed over rounds
+    uint64_t pairNs;   // One send + one receive at this backlog, summed
+    uint32_t pairs;
+} Result_t;
+
+// --- Queue adapters ---
+
+static BaseType_t Prio_Send(void *queue, uint16_t item, uint8_t severity)
+{
+    return PrioQueue_Send((PrioQueueHandle_t)queue, &item, severity, 0);
+}
+
+static BaseType_t Prio_Receive(void *queue, uint16_t *item)
+{
+    return PrioQueue_Receive((PrioQueueHandle_t)queue, item, 0);
+}
+
+static BaseType_t Fifo_Send(void *queue, uint16_t item, uint8_t severity)
+{
+    (void)severity;
+    return xQueueSend((QueueHandle_t)queue, &item, 0);
+}
+
+static BaseType_t Fifo_Receive(void *queue, uint16_t *item)
+{
+    return xQueueReceive((QueueHandle_t)queue, item, 0);
+}
+
+typedef BaseType_t (*SendFn_t)(void *queue, uint16_t item, uint8_t severity);
+typedef BaseType_t (*ReceiveFn_t)(void *queue, uint16_t *item);
+
+/**
+ * @brief Runs every round of one backlog size on one queue.
+ */
+static void Bench_Run(void *queue, SendFn_t send, ReceiveFn_t receive, uint32_t backlog, uint64_t *rng, Result_t *result)
+{
+    uint32_t round, i, ahead;
+    uint16_t item;
+    uint64_t start, probeNs;
+
+    *result = (Result_t){0};
+    for (round = 0; round < ROUNDS; ++round)
+    {
+        // 1. Backlog of less severe calls
+        for (i = 0; i < backlog; ++i)
+        {
+            BENCH_CHECK(send(queue, (uint16_t)i, (uint8_t)Bench_RandomBelow(rng, EVENT_SEVERITY_CRITICAL)) == pdPASS, "backlog send");
+        }
+
+        // 2. Steady state at this backlog: one call in, one call out
+        start = Bench_NowNs();
+        for (i = 0; i < PAIRS_PER_ROUND; ++i)
+        {
+            (void)send(queue, (uint16_t)i, (uint8_t)Bench_RandomBelow(rng, EVENT_SEVERITY_CRITICAL));
+            (void)receive(queue, &item);
+        }
+        result->pairNs += Bench_NowNs() - start;
+        result->pairs += PAIRS_PER_ROUND;
+
+        // 3. The critical call, and everything served before it
+        start = Bench_NowNs();
+        BENCH_CHECK(send(queue, CRITICAL_TAG, EVENT_SEVERITY_CRITICAL) == pdPASS, "critical send");
+        probeNs = Bench_NowNs() - start;
+        ahead = 0;
+        for (;;)
+        {
+            start = Bench_NowNs();
+            BENCH_CHECK(receive(queue, &item) == pdPASS, "critical call lost");
+            if (item == CRITICAL_TAG)
+            {
+                probeNs += Bench_NowNs() - start;
+                break;
+            }
+            ahead++;
+        }
+        result->probeNs += probeNs;
+        if (ahead > result->maxAhead)
+        {
+            result->maxAhead = ahead;
+        }
+
+        // 4. Empty the queue for the next round
+        while (receive(queue, &item) == pdPASS)
+        {
+        }
+    }
+}
+
+int main(void)
+{
+    PrioQueueHandle_t prio = PrioQueue_Create(QUEUE_LENGTH, sizeof(uint16_t));
+    QueueHandle_t fifo = xQueueCreate(QUEUE_LENGTH, sizeof(uint16_t));
+    uint64_t rng = 1;
+    Result_t p, f;
+    size_t b;
+
+    BENCH_CHECK(prio != NULL && fifo != NULL, "queue creation");
+
+    printf("Critical call behind a backlog of LOW..HIGH calls, %d rounds per backlog\n", ROUNDS);
+    printf("wait = calls served first (worst case), i.e. queueing delay in service times\n\n");
+    printf("%8s | %-34s | %-34s\n", "", "prio_queue (severity levels)", "FreeRTOS queue (FIFO)");
+    printf("%8s | %8s %12s %12s | %8s %12s %12s\n", "backlog", "wait", "probe ns", "send+recv ns", "wait", "probe ns", "send+recv ns");
+
+    for (b = 0; b < sizeof(backlogs) / sizeof(backlogs[0]); ++b)
+    {
+        Bench_Run(prio, Prio_Send, Prio_Receive, backlogs[b], &rng, &p);
+        Bench_Run(fifo, Fifo_Send, Fifo_Receive, backlogs[b], &rng, &f);
+
+        printf("%8u | %8u %12.1f %12.1f | %8u %12.1f %12.1f\n", backlogs[b],
+               p.maxAhead, (double)p.probeNs / ROUNDS, (double)p.pairNs / p.pairs,
+               f.maxAhead, (double)f.probeNs / ROUNDS, (double)f.pairNs / f.pairs);
+
+        BENCH_CHECK(p.maxAhead == 0, "critical call waited behind %u less severe calls", p.maxAhead);
+        BENCH_CHECK(f.maxAhead == backlogs[b], "FIFO reference served %u calls first, expected %u", f.maxAhead, backlogs[b]);
+    }
+    return 0;
+}
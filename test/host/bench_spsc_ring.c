@@ -0,0 +1,177 @@
+/**
+ * @file bench_spsc_ring.c
+ * @brief Host benchmark: SPSC ring throughput against a FreeRTOS queue (spsc_ring.c).
+ *
+ * The producer side posts a burst of handles (as TIM2 does between two
+ * dispatcher wake-ups) and the consumer side drains it, for several burst
+ * sizes. The ring uses SpscRing_Push / SpscRing_Pop, the reference uses
+ * xQueueSendFromISR / xQueueReceive with no wait, which is what the dispatcher
+ * input used before. Both report items per second and the number of wake-ups
+ * the consumer would need: one per burst for the ring (empty -> non-empty
+ * transitions), one per item for the queue.
+ *
+ * Both sides pay a full host fence per barrier of the target code (stubs): for
+ * the ring, three __DMB per item plus two per drained burst (five for a burst
+ * of one); for the queue, one per BASEPRI raise, two per item. A host fence
+ * costs far more, relative to the rest of the code, than a DMB on the
+ * Cortex-M7, so the items/s columns compare barrier counts as much as code
+ * paths; the wake-up count does not depend on the host.
+ *
+ * A second run moves the producer to its own thread and checks that every
+ * handle arrives once and in order while both sides run concurrently.
+ *
+ * @date October 16, 2026
+ * @author shayb
+ */
+
+#include "bench.h"
+#include "spsc_ring.h"
+#include "queue.h"
+#include <pthread.h>
+
+#define RING_LENGTH 32U
+#define ITEMS_PER_BURST_SIZE 2000000U
+#define THREADED_ITEMS 1000000U
+
+static const uint32_t burstSizes[] = {1, 4, 8, 16, RING_LENGTH};
+
+static EventHandle_t ringStorage[RING_LENGTH];
+static SpscRing_t ring;
+
+/**
+ * @brief Throughput of one side at one burst size.
+ */
+typedef struct
+{
+    uint64_t ns;
+    uint32_t wakeups;
+} Result_t;
+
+static void Bench_Ring(uint32_t burst, Result_t *result)
+{
+    const uint32_t bursts = ITEMS_PER_BURST_SIZE / burst;
+    EventHandle_t expected = 0, handle;
+    BaseType_t wasEmpty;
+    uint32_t b, i;
+    uint64_t start;
+
+    *result = (Result_t){0};
+    start = Bench_NowNs();
+    for (b = 0; b < bursts; ++b)
+    {
+        for (i = 0; i < burst; ++i)
+        {
+            BENCH_CHECK(SpscRing_Push(&ring, (EventHandle_t)(expected + i), &wasEmpty) == pdPASS, "ring push");
+            result->wakeups += (wasEmpty == pdTRUE) ? 1U : 0U;
+        }
+        while (SpscRing_Pop(&ring, &handle) == pdPASS)
+        {
+            BENCH_CHECK(handle == expected, "ring order: got %u, expected %u", handle, expected);
+            expected++;
+        }
+    }
+    result->ns = Bench_NowNs() - start;
+}
+
+static void Bench_Queue(QueueHandle_t queue, uint32_t burst, Result_t *result)
+{
+    const uint32_t bursts = ITEMS_PER_BURST_SIZE / burst;
+    EventHandle_t expected = 0, handle;
+    BaseType_t woken;
+    uint32_t b, i;
+    uint64_t start;
+
+    *result = (Result_t){0};
+    start = Bench_NowNs();
+    for (b = 0; b < bursts; ++b)
+    {
+        for (i = 0; i < burst; ++i)
+        {
+            handle = (EventHandle_t)(expected + i);
+            BENCH_CHECK(xQueueSendFromISR(queue, &handle, &woken) == pdPASS, "queue send");
+            result->wakeups++; // The consumer was notified on every post
+        }
+        while (xQueueReceive(queue, &handle, 0) == pdPASS)
+        {
+            BENCH_CHECK(handle == expected, "queue order");
+            expected++;
+        }
+    }
+    result->ns = Bench_NowNs() - start;
+}
+
+static void *Bench_Producer(void *arg)
+{
+    uint32_t i;
+
+    (void)arg;
+    for (i = 0; i < THREADED_ITEMS; ++i)
+    {
+        while (SpscRing_Push(&ring, (EventHandle_t)i, NULL) != pdPASS)
+        {
+            sched_yield(); // Full: let the consumer run
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief Producer and consumer on separate threads: nothing lost, duplicated or reordered.
+ */
+static void Bench_Threaded(void)
+{
+    pthread_t producer;
+    EventHandle_t handle, expected = 0;
+    uint32_t received = 0;
+    uint64_t start;
+
+    start = Bench_NowNs();
+    BENCH_CHECK(pthread_create(&producer, NULL, Bench_Producer, NULL) == 0, "pthread_create");
+    while (received < THREADED_ITEMS)
+    {
+        if (SpscRing_Pop(&ring, &handle) != pdPASS)
+        {
+            sched_yield();
+            continue;
+        }
+        BENCH_CHECK(handle == expected, "threaded order: item %u is %u, expected %u", received, handle, expected);
+        expected++;
+        received++;
+    }
+    pthread_join(producer, NULL);
+    BENCH_CHECK(SpscRing_Count(&ring) == 0, "ring not empty after the run");
+
+    printf("\nProducer and consumer threads: %u handles received in order (%.1f ms)\n",
+           THREADED_ITEMS, (double)(Bench_NowNs() - start) / 1e6);
+}
+
+int main(void)
+{
+    QueueHandle_t queue = xQueueCreate(RING_LENGTH, sizeof(EventHandle_t));
+    Result_t r, q;
+    size_t b;
+
+    BENCH_CHECK(queue != NULL, "queue creation");
+    BENCH_CHECK(SpscRing_Init(&ring, ringStorage, RING_LENGTH) == pdPASS, "ring init");
+
+    printf("Bursts posted by the producer, drained by the consumer, %u items per burst size\n\n", ITEMS_PER_BURST_SIZE);
+    printf("%6s | %-24s | %-24s | %7s\n", "", "spsc_ring", "FreeRTOS queue", "");
+    printf("%6s | %12s %11s | %12s %11s | %7s\n", "burst", "Mitems/s", "wake-ups", "Mitems/s", "wake-ups", "ring x");
+
+    for (b = 0; b < sizeof(burstSizes) / sizeof(burstSizes[0]); ++b)
+    {
+        Bench_Ring(burstSizes[b], &r);
+        Bench_Queue(queue, burstSizes[b], &q);
+
+        printf("%6u | %12.1f %11u | %12.1f %11u | %6.1fx\n", burstSizes[b],
+               (double)ITEMS_PER_BURST_SIZE * 1e3 / (double)r.ns, r.wakeups,
+               (double)ITEMS_PER_BURST_SIZE * 1e3 / (double)q.ns, q.wakeups,
+               (double)q.ns / (double)r.ns);
+
+        BENCH_CHECK(r.wakeups == ITEMS_PER_BURST_SIZE / burstSizes[b], "ring reported %u wake-ups for %u bursts",
+                    r.wakeups, ITEMS_PER_BURST_SIZE / burstSizes[b]);
+    }
+
+    Bench_Threaded();
+    return 0;
+}
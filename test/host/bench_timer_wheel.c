@@ -0,0 +1,284 @@
+/**
+ * @file bench_timer_wheel.c
+ * @brief Host benchmark: timing wheel against the kernel's sorted timer lists (timer_wheel.c).
+ *
+ * TIMER_COUNT unit timers run concurrently for RUN_TICKS ticks. Each one is
+ * restarted with a new mission delay (1 tick .. 60 s at 1 kHz) as soon as it
+ * fires, so the number of running timers stays constant. The same schedule is
+ * run on three timer implementations:
+ *
+ *   - wheel:        TimerWheel_Start / TimerWheel_TickFromISR (timer_wheel.c);
+ *   - delayed list: the kernel's delayed task list, i.e. vListInsert sorted by
+ *                   wake tick and, on each tick, uxListRemove of the due items
+ *                   (what vTaskDelay and xTaskIncrementTick do per task);
+ *   - timer task:   FreeRTOS software timers, i.e. the same sorted list fed
+ *                   through the timer command queue (one xQueueSend and one
+ *                   xQueueReceive per start).
+ *
+ * The kernel paths are modelled on their list and queue operations only: the
+ * ready-list moves and the switches to the timer service task are not counted,
+ * so the kernel columns are a lower bound. Every time includes one clock read
+ * (about 20 ns on the reference host). Worst cases are reported as the 99.9th
+ * percentile: the maximum of a run on a desktop OS is set by its scheduler.
+ *
+ * Fails if any timer fires on a tick other than its expiry tick, or if the
+ * three implementations do not fire the same number of times.
+ *
+ * @date October 16, 2026
+ * @author shayb
+ */
+
+#include "bench.h"
+#include "timer_wheel.h"
+#include "list.h"
+#include "queue.h"
+#include <string.h>
+
+#define TIMER_COUNT 10000U
+#define RUN_TICKS 120000U       // 2 minutes at 1 kHz
+#define MAX_DELAY_TICKS 60000U  // Longest mission phase, 60 s at 1 kHz
+#define MAX_STARTS (TIMER_COUNT * (2U + 3U * RUN_TICKS / MAX_DELAY_TICKS)) // About 1 + 2 * RUN / MAX per timer on average
+
+/**
+ * @brief One timer implementation under test.
+ */
+typedef struct
+{
+    const char *name;
+    void (*init)(void);
+    void (*start)(uint32_t timer, TickType_t delayTicks);
+    void (*tick)(void);
+} TimerImpl_t;
+
+/**
+ * @brief Cost of one implementation over the whole run.
+ */
+typedef struct
+{
+    uint32_t startNs[MAX_STARTS]; // Every start, for the percentile
+    uint32_t tickNs[RUN_TICKS];   // Every tick
+    uint32_t starts;
+    uint32_t fires;
+} Result_t;
+
+static TickType_t nowTick;                 // Tick being processed
+static TickType_t expiryTick[TIMER_COUNT]; // Tick each timer must fire on
+static uint32_t fireCount[TIMER_COUNT];    // Fires so far, seeds the next delay
+static uint16_t firedTimers[TIMER_COUNT];  // Fired during the current tick, restarted after it
+static uint32_t firedCount;
+
+// --- Schedule ---
+
+/**
+ * @brief Delay of a timer's next mission, independent of the order timers fire in.
+ */
+static TickType_t Bench_Delay(uint32_t timer)
+{
+    uint64_t state = ((uint64_t)timer << 32) | fireCount[timer];
+
+    return (TickType_t)Bench_RandomBelow(&state, MAX_DELAY_TICKS) + 1U;
+}
+
+static void Bench_Fired(uint32_t timer)
+{
+    BENCH_CHECK(expiryTick[timer] == nowTick, "timer %u fired on tick %u, expected %u", timer, nowTick, expiryTick[timer]);
+    fireCount[timer]++;
+    firedTimers[firedCount++] = (uint16_t)timer;
+}
+
+// --- Timing wheel ---
+
+static TimerWheelTimer_t wheelTimers[TIMER_COUNT];
+
+static void Wheel_Expired(TimerWheelTimer_t *timer, BaseType_t *pxHigherPriorityTaskWoken)
+{
+    (void)pxHigherPriorityTaskWoken;
+    Bench_Fired((uint32_t)(uintptr_t)timer->context);
+}
+
+static void Wheel_Init(void)
+{
+    uint32_t i;
+
+    for (i = 0; i < TIMER_COUNT; ++i)
+    {
+        TimerWheel_InitTimer(&wheelTimers[i], Wheel_Expired, (void *)(uintptr_t)i);
+    }
+}
+
+static void Wheel_Start(uint32_t timer, TickType_t delayTicks)
+{
+    TimerWheel_Start(&wheelTimers[timer], delayTicks);
+}
+
+static void Wheel_Tick(void)
+{
+    BaseType_t woken = pdFALSE;
+
+    TimerWheel_TickFromISR(&woken);
+}
+
+// --- Kernel sorted list (delayed task list / active timer list) ---
+
+static List_t sortedList;
+static ListItem_t listItems[TIMER_COUNT];
+static QueueHandle_t commandQueue;
+
+/**
+ * @brief Timer command as posted by xTimerStart (DaemonTaskMessage_t, reduced).
+ */
+typedef struct
+{
+    uint32_t timer;
+    TickType_t expiry;
+} TimerCommand_t;
+
+static void List_Init(void)
+{
+    uint32_t i;
+
+    vListInitialise(&sortedList);
+    for (i = 0; i < TIMER_COUNT; ++i)
+    {
+        vListInitialiseItem(&listItems[i]);
+        listSET_LIST_ITEM_OWNER(&listItems[i], (void *)(uintptr_t)i);
+    }
+}
+
+static void List_Start(uint32_t timer, TickType_t delayTicks)
+{
+    listSET_LIST_ITEM_VALUE(&listItems[timer], nowTick + delayTicks);
+    vListInsert(&sortedList, &listItems[timer]);
+}
+
+static void List_Tick(void)
+{
+    UBaseType_t uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+
+    while (!listLIST_IS_EMPTY(&sortedList) && listGET_ITEM_VALUE_OF_HEAD_ENTRY(&sortedList) <= nowTick)
+    {
+        ListItem_t *item = listGET_HEAD_ENTRY(&sortedList);
+
+        (void)uxListRemove(item);
+        Bench_Fired((uint32_t)(uintptr_t)listGET_LIST_ITEM_OWNER(item));
+    }
+    portCLEAR_INTERRUPT_MASK_FROM_ISR(uxSavedInterruptStatus);
+}
+
+static void TimerTask_Start(uint32_t timer, TickType_t delayTicks)
+{
+    TimerCommand_t command = {timer, nowTick + delayTicks};
+
+    // xTimerStart posts the command, the timer service task files it
+    BENCH_CHECK(xQueueSend(commandQueue, &command, 0) == pdPASS, "timer command queue full");
+    BENCH_CHECK(xQueueReceive(commandQueue, &command, 0) == pdPASS, "timer command lost");
+    listSET_LIST_ITEM_VALUE(&listItems[command.timer], command.expiry);
+    vListInsert(&sortedList, &listItems[command.timer]);
+}
+
+// --- Driver ---
+
+static void Bench_Start(const TimerImpl_t *impl, uint32_t timer, Result_t *result)
+{
+    const TickType_t delayTicks = Bench_Delay(timer);
+    uint64_t start, elapsed;
+
+    expiryTick[timer] = nowTick + delayTicks;
+    start = Bench_NowNs();
+    impl->start(timer, delayTicks);
+    elapsed = Bench_NowNs() - start;
+
+    BENCH_CHECK(result->starts < MAX_STARTS, "more starts than MAX_STARTS");
+    result->startNs[result->starts++] = (uint32_t)elapsed;
+}
+
+static int Bench_CompareNs(const void *a, const void *b)
+{
+    const uint32_t x = *(const uint32_t *)a, y = *(const uint32_t *)b;
+
+    return (x > y) - (x < y);
+}
+
+/**
+ * @brief Mean and 99.9th percentile of a set of durations (sorts them).
+ */
+static void Bench_Summary(uint32_t *ns, uint32_t count, double *mean, uint32_t *p999)
+{
+    uint64_t total = 0;
+    uint32_t i;
+
+    for (i = 0; i < count; ++i)
+    {
+        total += ns[i];
+    }
+    qsort(ns, count, sizeof(ns[0]), Bench_CompareNs);
+    *mean = (double)total / count;
+    *p999 = ns[(uint32_t)((uint64_t)count * 999U / 1000U)];
+}
+
+static void Bench_Run(const TimerImpl_t *impl, Result_t *result)
+{
+    uint64_t start, elapsed;
+    uint32_t tick, i;
+
+    result->starts = 0;
+    result->fires = 0;
+    memset(fireCount, 0, sizeof(fireCount));
+    nowTick = 0;
+    impl->init();
+
+    for (i = 0; i < TIMER_COUNT; ++i)
+    {
+        Bench_Start(impl, i, result);
+    }
+    for (tick = 0; tick < RUN_TICKS; ++tick)
+    {
+        firedCount = 0;
+        nowTick++;
+        start = Bench_NowNs();
+        impl->tick();
+        elapsed = Bench_NowNs() - start;
+
+        result->tickNs[tick] = (uint32_t)elapsed;
+        result->fires += firedCount;
+
+        // Units pick up their next mission after the tick
+        for (i = 0; i < firedCount; ++i)
+        {
+            Bench_Start(impl, firedTimers[i], result);
+        }
+    }
+}
+
+int main(void)
+{
+    // The wheel's tick counter cannot be reset, so it runs first, from tick 0
+    static const TimerImpl_t impls[] = {
+        {"wheel", Wheel_Init, Wheel_Start, Wheel_Tick},
+        {"delayed list", List_Init, List_Start, List_Tick},
+        {"timer task", List_Init, TimerTask_Start, List_Tick},
+    };
+    static Result_t results[sizeof(impls) / sizeof(impls[0])];
+    double startMean, tickMean;
+    uint32_t startP999, tickP999;
+    size_t i;
+
+    commandQueue = xQueueCreate(1, sizeof(TimerCommand_t));
+    BENCH_CHECK(commandQueue != NULL, "queue creation");
+
+    printf("%u concurrent timers, delays 1..%u ticks, %u ticks\n\n", TIMER_COUNT, MAX_DELAY_TICKS, RUN_TICKS);
+    printf("%-12s | %9s %12s %12s | %12s %12s\n", "", "starts", "start ns", "p99.9 ns", "tick ns", "p99.9 ns");
+
+    for (i = 0; i < sizeof(impls) / sizeof(impls[0]); ++i)
+    {
+        Result_t *r = &results[i];
+
+        Bench_Run(&impls[i], r);
+        Bench_Summary(r->startNs, r->starts, &startMean, &startP999);
+        Bench_Summary(r->tickNs, RUN_TICKS, &tickMean, &tickP999);
+        printf("%-12s | %9u %12.1f %12u | %12.1f %12u\n", impls[i].name, r->starts, startMean, startP999, tickMean, tickP999);
+
+        BENCH_CHECK(r->fires > 0 && r->fires == results[0].fires, "%s fired %u times, wheel %u", impls[i].name, r->fires, results[0].fires);
+    }
+    return 0;
+}
@@ -0,0 +1,37 @@
+/**
+ * @file sample_service_time.c
+ * @brief Host sampler for the service-time fidelity test (service_time.c).
+ *
+ * Draws service times through ServiceTime_DrawMs with the generated tables and
+ * prints one value in milliseconds per line. tools/test_service_time_fidelity.py
+ * compares them with the distributions the tables were generated from.
+ *
+ * Usage: sample_service_time <department> <count>
+ *
+ * @date October 16, 2026
+ * @author shayb
+ */
+
+#include "bench.h"
+#include "service_time.h"
+
+int main(int argc, char **argv)
+{
+    uint64_t rng = 1;
+    unsigned long department, count, i;
+
+    if (argc != 3)
+    {
+        fprintf(stderr, "usage: %s <department> <count>\n", argv[0]);
+        return 2;
+    }
+    department = strtoul(argv[1], NULL, 10);
+    count = strtoul(argv[2], NULL, 10);
+    BENCH_CHECK(department < DEPT_COUNT, "department %lu out of range", department);
+
+    for (i = 0; i < count; ++i)
+    {
+        printf("%lu\n", (unsigned long)ServiceTime_DrawMs((uint8_t)department, (uint32_t)(Bench_Random(&rng) >> 32)));
+    }
+    return 0;
+}
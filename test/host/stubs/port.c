@@ -0,0 +1,34 @@
+/**
+ * @file port.c
+ * @brief Port layer stubs of the host build (test/host).
+ *
+ * The scheduler is never started on the host, so the context-switch hooks of a
+ * real port are never reached; they only satisfy the linker.
+ *
+ * @date October 16, 2026
+ * @author shayb
+ */
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include <stdlib.h>
+
+StackType_t *pxPortInitialiseStack(StackType_t *pxTopOfStack, TaskFunction_t pxCode, void *pvParameters)
+{
+    (void)pxCode;
+    (void)pvParameters;
+    return pxTopOfStack;
+}
+
+BaseType_t xPortStartScheduler(void)
+{
+    abort(); // The host build only uses kernel objects, never the scheduler
+}
+
+void vPortEndScheduler(void)
+{
+}
+
+void vApplicationTickHook(void)
+{
+}
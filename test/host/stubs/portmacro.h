@@ -0,0 +1,64 @@
+/**
+ * @file portmacro.h
+ * @brief Minimal FreeRTOS port for the host build (test/host).
+ *
+ * The scheduler never runs on the host: the kernel is only linked for its
+ * queues, semaphores and lists, called from a single thread. Critical sections
+ * and interrupt masking therefore have nothing to mask. They still execute the
+ * host fence where the Cortex-M7 port raises BASEPRI (msr, isb, dsb), so kernel
+ * calls pay for the same barriers as the lock-free code built with __DMB.
+ *
+ * @date October 16, 2026
+ * @author shayb
+ */
+
+#ifndef PORTMACRO_H
+#define PORTMACRO_H
+
+#include <stdint.h>
+
+/* Type definitions. */
+#define portCHAR		char
+#define portFLOAT		float
+#define portDOUBLE		double
+#define portLONG		long
+#define portSHORT		short
+#define portSTACK_TYPE	uint32_t
+#define portBASE_TYPE	long
+#define portPOINTER_SIZE_TYPE uintptr_t
+
+typedef portSTACK_TYPE StackType_t;
+typedef long BaseType_t;
+typedef unsigned long UBaseType_t;
+typedef uint32_t TickType_t;
+
+#define portMAX_DELAY ( TickType_t ) 0xffffffffUL
+#define portTICK_TYPE_IS_ATOMIC 1
+
+/* Architecture specifics. */
+#define portSTACK_GROWTH			( -1 )
+#define portTICK_PERIOD_MS			( ( TickType_t ) 1000 / configTICK_RATE_HZ )
+#define portBYTE_ALIGNMENT			8
+#define portNOP()
+
+/* Scheduler utilities: nothing to switch to. */
+#define portYIELD()
+#define portYIELD_WITHIN_API()
+#define portEND_SWITCHING_ISR( xSwitchRequired ) ( void ) ( xSwitchRequired )
+#define portYIELD_FROM_ISR( x ) portEND_SWITCHING_ISR( x )
+
+/* Critical section management: single-threaded, nothing to mask, only the
+barrier of the target's BASEPRI raise is kept. */
+#define portHOST_BARRIER() __atomic_thread_fence( __ATOMIC_SEQ_CST )
+#define portDISABLE_INTERRUPTS() portHOST_BARRIER()
+#define portENABLE_INTERRUPTS()
+#define portENTER_CRITICAL() portHOST_BARRIER()
+#define portEXIT_CRITICAL()
+#define portSET_INTERRUPT_MASK_FROM_ISR() ( portHOST_BARRIER(), 0 )
+#define portCLEAR_INTERRUPT_MASK_FROM_ISR( x ) ( void ) ( x )
+
+/* Task function macros as described on the FreeRTOS.org WEB site. */
+#define portTASK_FUNCTION_PROTO( vFunction, pvParameters ) void vFunction( void *pvParameters )
+#define portTASK_FUNCTION( vFunction, pvParameters ) void vFunction( void *pvParameters )
+
+#endif /* PORTMACRO_H */
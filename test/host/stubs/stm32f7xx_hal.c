@@ -0,0 +1,42 @@
+/**
+ * @file stm32f7xx_hal.c
+ * @brief Host stand-in for the STM32 HAL: register blocks and timer calls (test/host).
+ *
+ * The timer calls only set and clear the enable bits, as the HAL does; the
+ * counter never runs by itself (see stm32f7xx_hal.h).
+ *
+ * @date October 16, 2026
+ * @author shayb
+ */
+
+#include "stm32f7xx_hal.h"
+
+TIM_TypeDef hostTim1, hostTim2;
+RCC_TypeDef hostRcc;
+DWT_Type hostDwt;
+CoreDebug_Type hostCoreDebug;
+RNG_TypeDef hostRng;
+uint32_t SystemCoreClock = 216000000UL; // Firmware clock tree: HCLK 216 MHz
+
+HAL_StatusTypeDef HAL_TIM_Base_Start_IT(TIM_HandleTypeDef *htim)
+{
+    htim->Instance->DIER |= TIM_DIER_UIE;
+    __HAL_TIM_ENABLE(htim);
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_TIM_Base_Stop_IT(TIM_HandleTypeDef *htim)
+{
+    htim->Instance->DIER &= ~TIM_DIER_UIE;
+    __HAL_TIM_DISABLE(htim);
+    return HAL_OK;
+}
+
+uint32_t HAL_RCC_GetPCLK1Freq(void)
+{
+    return 54000000UL; // Firmware clock tree: HCLK 216 MHz, APB1 / 4
+}
+
+void HAL_IncTick(void)
+{
+}
@@ -0,0 +1,124 @@
+/**
+ * @file stm32f7xx_hal.h
+ * @brief Host stand-in for the STM32 HAL (test/host).
+ *
+ * Core/Inc/main.h and project_config.h include the HAL; the modules built on
+ * the host only need the handle types named there and the CMSIS intrinsics,
+ * mapped here to compiler builtins. The barrier is a full fence, the host
+ * equivalent of a DMB.
+ *
+ * The event generator also drives TIM2 through its registers, and the time
+ * base sets up the DWT, so the timer, RCC, DWT and CoreDebug registers they
+ * touch exist as plain memory (stm32f7xx_hal.c). Nothing counts on its own: a test plays the timer by reading ARR and calling
+ * HAL_TIM_PeriodElapsedCallback while the update interrupt is enabled.
+ *
+ * @date October 16, 2026
+ * @author shayb
+ */
+
+#ifndef STM32F7xx_HAL_H
+#define STM32F7xx_HAL_H
+
+#include <stdint.h>
+
+typedef enum
+{
+    HAL_OK = 0x00U,
+    HAL_ERROR = 0x01U
+} HAL_StatusTypeDef;
+
+// --- Registers (only the ones the firmware modules touch) ---
+
+typedef struct
+{
+    volatile uint32_t CR1;
+    volatile uint32_t DIER;
+    volatile uint32_t SR;
+    volatile uint32_t EGR;
+    volatile uint32_t CNT;
+    volatile uint32_t PSC;
+    volatile uint32_t ARR;
+} TIM_TypeDef;
+
+typedef struct
+{
+    volatile uint32_t CFGR;
+} RCC_TypeDef;
+
+typedef struct
+{
+    volatile uint32_t CTRL;
+    volatile uint32_t CYCCNT;
+    volatile uint32_t LAR;
+} DWT_Type;
+
+typedef struct
+{
+    volatile uint32_t DEMCR;
+} CoreDebug_Type;
+
+typedef struct
+{
+    uint32_t unused;
+} RNG_TypeDef;
+
+extern TIM_TypeDef hostTim1, hostTim2;
+extern RCC_TypeDef hostRcc;
+extern DWT_Type hostDwt;
+extern CoreDebug_Type hostCoreDebug;
+extern RNG_TypeDef hostRng;
+
+#define TIM1 (&hostTim1)
+#define TIM2 (&hostTim2)
+#define RCC (&hostRcc)
+#define DWT (&hostDwt)
+#define CoreDebug (&hostCoreDebug)
+#define RNG (&hostRng)
+
+#define DWT_CTRL_CYCCNTENA_Msk (1UL << 0)
+#define CoreDebug_DEMCR_TRCENA_Msk (1UL << 24)
+
+extern uint32_t SystemCoreClock;
+
+#define TIM_CR1_CEN (1UL << 0)
+#define TIM_CR1_URS (1UL << 2)
+#define TIM_CR1_ARPE (1UL << 7)
+#define TIM_DIER_UIE (1UL << 0)
+#define TIM_SR_UIF (1UL << 0)
+#define TIM_EGR_UG (1UL << 0)
+#define TIM_FLAG_UPDATE TIM_SR_UIF
+#define RCC_CFGR_PPRE1 (7UL << 10)
+#define RCC_HCLK_DIV1 0UL
+
+// --- Handles ---
+
+typedef struct
+{
+    TIM_TypeDef *Instance;
+} TIM_HandleTypeDef;
+
+typedef struct
+{
+    RNG_TypeDef *Instance;
+} RNG_HandleTypeDef;
+
+#define __HAL_TIM_ENABLE(h) ((h)->Instance->CR1 |= TIM_CR1_CEN)
+#define __HAL_TIM_DISABLE(h) ((h)->Instance->CR1 &= ~TIM_CR1_CEN)
+#define __HAL_TIM_SET_PRESCALER(h, v) ((h)->Instance->PSC = (v))
+#define __HAL_TIM_SET_COUNTER(h, v) ((h)->Instance->CNT = (v))
+#define __HAL_TIM_CLEAR_FLAG(h, f) ((h)->Instance->SR = ~(uint32_t)(f))
+
+HAL_StatusTypeDef HAL_TIM_Base_Start_IT(TIM_HandleTypeDef *htim);
+HAL_StatusTypeDef HAL_TIM_Base_Stop_IT(TIM_HandleTypeDef *htim);
+void HAL_TIM_PeriodElapsedCallback(TIM_HandleTypeDef *htim);
+uint32_t HAL_RCC_GetPCLK1Freq(void);
+void HAL_IncTick(void);
+
+static inline uint32_t __CLZ(uint32_t value)
+{
+    return (value == 0U) ? 32U : (uint32_t)__builtin_clz(value);
+}
+
+#define __DMB() __atomic_thread_fence(__ATOMIC_SEQ_CST)
+
+#endif /* STM32F7xx_HAL_H */
@@ -0,0 +1,249 @@
+/**
+ * @file test_time_dilation.c
+ * @brief Host test: department saturation at 1x against dilated time (unit_lifecycle.c, time_base.c).
+ *
+ * Each department is run as a first-come first-served queue in front of its
+ * RESOURCES_* units, fed by Poisson arrivals at LOAD of its capacity. Missions
+ * are planned by UnitLifecycle_PlanMission, with the on-scene time drawn from
+ * the service-time tables as GetRandomTaskDurationTicks does, and last for the
+ * wall-clock ticks the timing wheel runs them for, scaled back to simulated
+ * time: the wheel ends a phase on a tick, so a mission that starts part-way
+ * into a tick loses that part. A unit is free again once its call is cleared:
+ * a returning unit can be re-tasked. Every factor sees the same arrivals and
+ * the same draws, so the runs differ only in the tick rounding that dilation
+ * coarsens.
+ *
+ * Reported per department and factor: utilization, the share of calls that
+ * wait, and the queue-wait percentiles as the upper bounds of their log2
+ * buckets (the latency dump's layout). Not modelled: dispatching and logging,
+ * which take the same wall time at any factor and so count that many times
+ * more in simulated time, and severity order, which is the same at any factor.
+ *
+ * Fails if, up to MATCH_FACTOR, a department's utilization moves by more than
+ * MATCH_UTILIZATION or a wait percentile leaves the 1x bucket or its
+ * neighbours. Larger factors are only reported: past about 120x the shortest
+ * phases (20 ms of police turnout) are far below one tick.
+ *
+ * @date October 16, 2026
+ * @author shayb
+ */
+
+#include "bench.h"
+#include "unit_lifecycle.h"
+#include "resource_task.h"
+#include "rng_service.h"
+#include "service_time.h"
+#include "time_base.h"
+#include <math.h>
+#include <string.h>
+
+#define CALLS 200000U
+#define LOAD 0.9             // Offered load per unit
+#define MATCH_FACTOR 60U     // Largest factor that must match the 1x run
+#define MATCH_UTILIZATION 0.01
+
+static const uint32_t factors[] = {1, 2, 5, 10, 30, 60, 120, 300};
+static const uint8_t percentiles[] = {50, 90, 99};
+static const uint16_t unitCounts[DEPT_COUNT] = {
+    [DEPT_POLICE] = RESOURCES_POLICE,
+    [DEPT_AMBULANCE] = RESOURCES_AMBULANCE,
+    [DEPT_FIRE] = RESOURCES_FIRE_DEPT,
+};
+static const char *const deptNames[DEPT_COUNT] = {"Police", "Ambulance", "Fire"};
+
+/**
+ * @brief Saturation figures of one run.
+ */
+typedef struct
+{
+    double utilization;
+    double waitingShare;
+    uint32_t buckets[LATENCY_HIST_BUCKETS];
+} Result_t;
+
+static uint64_t rngState;
+static uint64_t arrivalUs[CALLS];
+
+// --- Firmware stand-ins ---
+
+uint32_t RngService_Next(void)
+{
+    return (uint32_t)(Bench_Random(&rngState) >> 32);
+}
+
+/**
+ * @brief Table model of GetRandomTaskDurationTicks (resource_task.c).
+ */
+uint32_t GetRandomTaskDurationTicks(uint8_t department)
+{
+    uint32_t ticks = TimeBase_MsToTicks(ServiceTime_DrawMs(department, RngService_Next()));
+
+    return (ticks > 0) ? ticks : 1U;
+}
+
+// --- Model ---
+
+static uint8_t Test_Bucket(uint64_t us)
+{
+    uint32_t bucket = (us == 0) ? 0U : 64U - (uint32_t)__builtin_clzll(us);
+
+    return (bucket < LATENCY_HIST_BUCKETS) ? (uint8_t)bucket : (LATENCY_HIST_BUCKETS - 1U);
+}
+
+/**
+ * @brief Bucket holding the @p percent percentile of a histogram.
+ */
+static uint32_t Test_PercentileBucket(const Result_t *r, uint8_t percent)
+{
+    const uint64_t target = ((uint64_t)CALLS * percent + 99U) / 100U;
+    uint64_t seen = 0;
+    uint32_t i;
+
+    for (i = 0; i < LATENCY_HIST_BUCKETS - 1U; ++i)
+    {
+        seen += r->buckets[i];
+        if (seen >= target)
+        {
+            break;
+        }
+    }
+    return i;
+}
+
+/**
+ * @brief Upper bound of a bucket in milliseconds (0 for bucket 0).
+ */
+static double Test_BucketMs(uint32_t bucket)
+{
+    return (bucket == 0) ? 0.0 : (double)(1ULL << bucket) / 1000.0;
+}
+
+/**
+ * @brief Simulated busy time of a mission started at @p startUs, as the timing wheel runs it.
+ */
+static uint64_t Test_BusyUs(const UnitMission_t *mission, uint64_t startUs)
+{
+    const uint64_t simUsPerTick = TimeBase_TicksToUs(1) * TimeBase_GetDilation();
+
+    return TimeBase_TicksToUs(UnitLifecycle_BusyTicks(mission)) * TimeBase_GetDilation() - (startUs % simUsPerTick);
+}
+
+/**
+ * @brief Mean simulated busy time of the department's missions at 1x, in us.
+ */
+static double Test_MeanBusyUs(uint8_t department)
+{
+    EmergencyEvent_t event;
+    UnitMission_t mission;
+    uint64_t totalUs = 0;
+    uint32_t i;
+
+    BENCH_CHECK(TimeBase_SetDilation(1) == pdPASS, "dilation 1");
+    rngState = 0x9E3779B97F4A7C15ULL ^ department;
+    for (i = 0; i < CALLS; ++i)
+    {
+        memset(&event, 0, sizeof(event));
+        (void)UnitLifecycle_PlanMission(department, &event, &mission);
+        totalUs += TimeBase_TicksToUs(UnitLifecycle_BusyTicks(&mission));
+    }
+    return (double)totalUs / CALLS;
+}
+
+static void Test_Run(uint8_t department, uint32_t factor, Result_t *r)
+{
+    uint64_t freeUs[RESOURCES_AMBULANCE + RESOURCES_POLICE + RESOURCES_FIRE_DEPT] = {0};
+    const uint16_t units = unitCounts[department];
+    EmergencyEvent_t event;
+    UnitMission_t mission;
+    uint64_t busyUs = 0, waiting = 0;
+    uint32_t i, u, first;
+
+    memset(r, 0, sizeof(*r));
+    BENCH_CHECK(TimeBase_SetDilation(factor) == pdPASS, "dilation %u", factor);
+    rngState = 0x9E3779B97F4A7C15ULL ^ department; // Same draws at every factor
+
+    for (i = 0; i < CALLS; ++i)
+    {
+        uint64_t startUs, missionUs;
+
+        // The unit that clears its call first takes the next one
+        for (first = 0, u = 1; u < units; ++u)
+        {
+            first = (freeUs[u] < freeUs[first]) ? u : first;
+        }
+        startUs = (freeUs[first] > arrivalUs[i]) ? freeUs[first] : arrivalUs[i];
+
+        memset(&event, 0, sizeof(event));
+        (void)UnitLifecycle_PlanMission(department, &event, &mission);
+        missionUs = Test_BusyUs(&mission, startUs);
+        freeUs[first] = startUs + missionUs;
+        busyUs += missionUs;
+
+        waiting += (startUs > arrivalUs[i]);
+        r->buckets[Test_Bucket(startUs - arrivalUs[i])]++;
+    }
+    r->utilization = (double)busyUs / ((double)arrivalUs[CALLS - 1U] * units);
+    r->waitingShare = (double)waiting / CALLS;
+}
+
+int main(void)
+{
+    static Result_t results[sizeof(factors) / sizeof(factors[0])];
+    uint32_t failures = 0;
+    uint8_t department;
+    size_t f, p;
+
+    printf("FCFS department queues at %.0f%% offered load, %u calls, wall-clock phase ticks scaled to simulated time\n", LOAD * 100.0, CALLS);
+    printf("Wait percentiles are log2 bucket upper bounds (ms); must match 1x up to x%u\n", MATCH_FACTOR);
+
+    for (department = 0; department < DEPT_COUNT; ++department)
+    {
+        const double meanBusyUs = Test_MeanBusyUs(department);
+        const double gapUs = meanBusyUs / (LOAD * unitCounts[department]);
+        uint64_t arrivalRng = 0xD1B54A32D192ED03ULL ^ department;
+        double nowUs = 0.0;
+        uint32_t i;
+
+        for (i = 0; i < CALLS; ++i)
+        {
+            nowUs += -log(((double)(Bench_Random(&arrivalRng) >> 11) + 0.5) / 9007199254740992.0) * gapUs;
+            arrivalUs[i] = (uint64_t)nowUs;
+        }
+
+        printf("\n%s: %u units, mean mission %.0f ms at 1x\n", deptNames[department], unitCounts[department], meanBusyUs / 1000.0);
+        printf("%6s | %11s %8s | %9s %9s %9s\n", "factor", "utilization", "waiting", "p50 ms", "p90 ms", "p99 ms");
+        for (f = 0; f < sizeof(factors) / sizeof(factors[0]); ++f)
+        {
+            Result_t *r = &results[f];
+
+            Test_Run(department, factors[f], r);
+            printf("%5ux | %10.1f%% %7.1f%% |", factors[f], r->utilization * 100.0, r->waitingShare * 100.0);
+            for (p = 0; p < sizeof(percentiles) / sizeof(percentiles[0]); ++p)
+            {
+                printf(" %9.0f", Test_BucketMs(Test_PercentileBucket(r, percentiles[p])));
+            }
+            printf("\n");
+
+            if (factors[f] > MATCH_FACTOR)
+            {
+                continue;
+            }
+            if (fabs(r->utilization - results[0].utilization) > MATCH_UTILIZATION)
+            {
+                fprintf(stderr, "FAIL: %s at x%u: utilization %.3f, 1x %.3f\n", deptNames[department], factors[f], r->utilization, results[0].utilization);
+                failures++;
+            }
+            for (p = 0; p < sizeof(percentiles) / sizeof(percentiles[0]); ++p)
+            {
+                const int32_t drift = (int32_t)Test_PercentileBucket(r, percentiles[p]) - (int32_t)Test_PercentileBucket(&results[0], percentiles[p]);
+
+                if (drift > 1 || drift < -1)
+                {
+                    fprintf(stderr, "FAIL: %s at x%u: p%u wait %d buckets from 1x\n", deptNames[department], factors[f], percentiles[p], drift);
+                    failures++;
+                }
+            }
+        }
+    }
+    return (failures == 0) ? 0 : 1;
+}
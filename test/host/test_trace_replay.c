@@ -0,0 +1,334 @@
+/**
+ * @file test_trace_replay.c
+ * @brief Host test: trace replay through the event generator ISR (event_generator.c, trace.c).
+ *
+ * The test plays TIM2: while its update interrupt is enabled, it advances the
+ * simulated clock by the programmed period (ARR + 1 counts of 1 us) and calls
+ * HAL_TIM_PeriodElapsedCallback. The calls the generator posts are captured in
+ * place of the dispatcher.
+ *
+ *   - replay: every call of a short trace, gap records included, reaches the
+ *     dispatcher at its recorded time with its code and severity, with one
+ *     timer interrupt per call;
+ *   - end of a non-looping replay: the timer is stopped with the last call,
+ *     instead of being re-armed for its 2 us minimum forever;
+ *   - end with a call held back by admission control: the timer keeps firing
+ *     every ADMISSION_DEFER_RETRY_US until the call is admitted, then stops;
+ *   - round trip: the recorder captures the replayed calls, TraceRecorder_Dump
+ *     logs them as hex words, and the words parsed back from the log are the
+ *     original image. Saved to a file, mapped by TraceReplay_LoadFile and
+ *     replayed, they give the same calls again and the same end of replay.
+ *
+ * @date October 16, 2026
+ * @author shayb
+ */
+
+#include "bench.h"
+#include "main.h"
+#include "trace.h"
+#include "event_generator.h"
+#include "event_pool.h"
+#include "admission.h"
+#include "time_base.h"
+#include "rng_service.h"
+#include "logging.h"
+#include "timers.h"
+#include <stdarg.h>
+#include <string.h>
+#include <unistd.h>
+
+#if TRACE_REPLAY_LOOP
+#error "The end-of-replay checks need TRACE_REPLAY_LOOP 0"
+#endif
+
+#define MAX_CALLS 64U
+#define DEFER_RETRIES 5U // Updates the deferred call is kept waiting for
+
+/**
+ * @brief A call as the dispatcher received it.
+ */
+typedef struct
+{
+    TimeStamp_t atUs;
+    uint8_t eventCode;
+    uint8_t severity;
+} PostedCall_t;
+
+// Delays of at least 2 us: shorter ones are stretched to the timer's minimum period
+static const uint32_t replayImage[] = {
+    TRACE_MAGIC, TRACE_VERSION, 7,
+    TRACE_RECORD(1500000, EVENT_CODE_POLICE, EVENT_SEVERITY_HIGH),
+    TRACE_RECORD(250000, EVENT_CODE_AMBULANCE, EVENT_SEVERITY_CRITICAL),
+    TRACE_RECORD(2, EVENT_CODE_FIRE_DEPT, EVENT_SEVERITY_MEDIUM),
+    TRACE_RECORD(TRACE_MAX_DELAY_US, 0, 0), // Long lull: 100 s in total before the next call
+    TRACE_RECORD(100000000UL - TRACE_MAX_DELAY_US, EVENT_CODE_AMBULANCE, EVENT_SEVERITY_LOW),
+    TRACE_RECORD(40000, EVENT_CODE_POLICE, EVENT_SEVERITY_MEDIUM),
+    TRACE_RECORD(731, EVENT_CODE_FIRE_DEPT, EVENT_SEVERITY_CRITICAL),
+};
+
+// The last call is low severity: deferred while the system is elevated
+static const uint32_t deferredImage[] = {
+    TRACE_MAGIC, TRACE_VERSION, 2,
+    TRACE_RECORD(300000, EVENT_CODE_FIRE_DEPT, EVENT_SEVERITY_HIGH),
+    TRACE_RECORD(20000, EVENT_CODE_POLICE, EVENT_SEVERITY_LOW),
+};
+
+TIM_HandleTypeDef htim2 = {TIM2}; // Defined by main.c in the firmware
+RNG_HandleTypeDef hrng = {RNG};
+
+static TimeStamp_t simNowUs;
+static PostedCall_t posted[MAX_CALLS];
+static uint32_t postedCount;
+static uint64_t rngState = 1;
+
+static uint32_t dumpWords[TRACE_HEADER_WORDS + TRACE_RECORDER_CAPACITY]; // Image parsed from the dump log
+static uint32_t dumpTotal;                                               // Words announced by the dump
+static uint32_t dumpParsed;                                              // Words parsed so far
+
+// --- Firmware Stand-ins ---
+
+BaseType_t Dispatcher_PostFromISR(EventHandle_t handle, uint8_t severity, BaseType_t *pxHigherPriorityTaskWoken)
+{
+    EmergencyEvent_t *event = EventPool_Get(handle);
+
+    (void)pxHigherPriorityTaskWoken;
+    BENCH_CHECK(postedCount < MAX_CALLS, "more than %u calls posted", MAX_CALLS);
+    posted[postedCount++] = (PostedCall_t){event->stamps[EVENT_STAGE_GENERATED], event->eventCode, severity};
+    EventPool_ReleaseFromISR(handle); // Served at once
+    return pdPASS;
+}
+
+TimeStamp_t TimeBase_SimNowUs(void)
+{
+    return simNowUs;
+}
+
+uint32_t TimeBase_GetDilation(void)
+{
+    return 1U;
+}
+
+uint64_t TimeBase_SimToWallUs(uint64_t simUs)
+{
+    return simUs;
+}
+
+uint32_t RngService_Next(void)
+{
+    return (uint32_t)(Bench_Random(&rngState) >> 32);
+}
+
+uint32_t RngService_NextFromISR(void)
+{
+    return RngService_Next();
+}
+
+/**
+ * @brief Captures the trace dump from the log.
+ *
+ * uint32_t is unsigned int on the host (unsigned long on the target), so the
+ * arguments are taken as they were passed instead of through the %lx
+ * conversions of the format.
+ */
+void Project_Log(LogLevel level, const char *file, int line, const char *format, ...)
+{
+    va_list args;
+    uint32_t i, index;
+
+    (void)level;
+    (void)file;
+    (void)line;
+    va_start(args, format);
+    if (strncmp(format, "--- Trace (", 11) == 0)
+    {
+        (void)va_arg(args, unsigned int); // Calls
+        (void)va_arg(args, unsigned int); // Records
+        dumpTotal = va_arg(args, unsigned int);
+        dumpParsed = 0;
+    }
+    else if (strncmp(format, "TRACE ", 6) == 0)
+    {
+        index = va_arg(args, unsigned int);
+        BENCH_CHECK(index == dumpParsed, "dump line at word %u, expected %u", index, dumpParsed);
+        for (i = 0; i < 8U; ++i)
+        {
+            const uint32_t word = va_arg(args, unsigned int);
+
+            if (index + i < dumpTotal)
+            {
+                dumpWords[dumpParsed++] = word;
+            }
+        }
+    }
+    va_end(args);
+}
+
+BaseType_t xTimerPendFunctionCallFromISR(PendedFunction_t xFunctionToPend, void *pvParameter1, uint32_t ulParameter2, BaseType_t *pxHigherPriorityTaskWoken)
+{
+    (void)xFunctionToPend;
+    (void)pvParameter1;
+    (void)ulParameter2;
+    (void)pxHigherPriorityTaskWoken;
+    return pdFAIL;
+}
+
+// --- Helpers ---
+
+static BaseType_t Test_TimerRunning(void)
+{
+    return ((TIM2->DIER & TIM_DIER_UIE) != 0 && (TIM2->CR1 & TIM_CR1_CEN) != 0) ? pdTRUE : pdFALSE;
+}
+
+/**
+ * @brief Lets TIM2 run for up to maxUpdates updates, or until it is stopped.
+ *
+ * @return Number of updates delivered.
+ */
+static uint32_t Test_PlayTimer(uint32_t maxUpdates)
+{
+    uint32_t updates = 0;
+
+    while (updates < maxUpdates && Test_TimerRunning())
+    {
+        simNowUs += TIM2->ARR + 1U; // 1 us per count
+        TIM2->CNT = 0;              // The update restarts the counter
+        HAL_TIM_PeriodElapsedCallback(&htim2);
+        updates++;
+    }
+    return updates;
+}
+
+/**
+ * @brief Starts the generator on a trace, with an empty pool and an idle system.
+ */
+static void Test_Start(const uint32_t *image, size_t lengthBytes)
+{
+    simNowUs = 0;
+    postedCount = 0;
+    EventPool_Init();
+    Admission_Publish(0, 1, 1);
+    BENCH_CHECK(TraceReplay_Load(image, lengthBytes) == pdPASS, "trace rejected");
+    BENCH_CHECK(EventGenerator_Init() == pdPASS, "generator init");
+    BENCH_CHECK(Test_TimerRunning(), "timer not started");
+}
+
+/**
+ * @brief Checks the posted calls against the records of an image.
+ */
+static void Test_CheckPosted(const uint32_t *image)
+{
+    TimeStamp_t atUs = 0;
+    uint32_t i, calls = 0;
+
+    for (i = 0; i < image[2]; ++i)
+    {
+        const uint32_t word = image[TRACE_HEADER_WORDS + i];
+
+        atUs += TRACE_RECORD_DELAY_US(word);
+        if (TRACE_RECORD_CODE(word) == 0)
+        {
+            continue; // Gap record
+        }
+        BENCH_CHECK(calls < postedCount, "call %u of the trace was not posted", calls);
+        BENCH_CHECK(posted[calls].atUs == atUs && posted[calls].eventCode == TRACE_RECORD_CODE(word) &&
+                        posted[calls].severity == TRACE_RECORD_SEVERITY(word),
+                    "call %u: posted code %u severity %u at %llu us, trace has %u/%u at %llu us", calls,
+                    posted[calls].eventCode, posted[calls].severity, (unsigned long long)posted[calls].atUs,
+                    TRACE_RECORD_CODE(word), TRACE_RECORD_SEVERITY(word), (unsigned long long)atUs);
+        calls++;
+    }
+    BENCH_CHECK(postedCount == calls, "%u calls posted, the trace has %u", postedCount, calls);
+}
+
+// --- Tests ---
+
+static void Test_Replay(void)
+{
+    uint32_t updates;
+
+    Test_Start(replayImage, sizeof(replayImage));
+    updates = Test_PlayTimer(MAX_CALLS);
+
+    Test_CheckPosted(replayImage);
+    BENCH_CHECK(!Test_TimerRunning(), "timer still running after the last call (%u updates)", updates);
+    BENCH_CHECK(updates == postedCount, "%u timer updates for %u calls", updates, postedCount);
+    printf("replay: %u calls over %.1f s, %u timer updates, timer stopped at the end\n",
+           postedCount, (double)simNowUs / 1e6, updates);
+}
+
+static void Test_RoundTrip(void)
+{
+    char path[] = "/tmp/test_trace_replay_XXXXXX";
+    uint32_t updates;
+    int fd;
+
+    // The recorder has captured the replay above: dump it and parse it back from the log
+    TraceRecorder_Dump();
+    BENCH_CHECK(dumpTotal > 0 && dumpParsed == dumpTotal, "dump announced %u words, %u logged", dumpTotal, dumpParsed);
+    BENCH_CHECK(dumpTotal == sizeof(replayImage) / sizeof(replayImage[0]) &&
+                    memcmp(dumpWords, replayImage, sizeof(replayImage)) == 0,
+                "recorded image differs from the replayed one");
+
+    // Saved as a binary file and mapped back
+    fd = mkstemp(path);
+    BENCH_CHECK(fd >= 0, "mkstemp");
+    BENCH_CHECK(write(fd, dumpWords, dumpTotal * sizeof(uint32_t)) == (ssize_t)(dumpTotal * sizeof(uint32_t)), "write %s", path);
+    close(fd);
+
+    simNowUs = 0;
+    postedCount = 0;
+    EventPool_Init();
+    BENCH_CHECK(TraceReplay_LoadFile(path) == pdPASS, "TraceReplay_LoadFile(%s) failed", path);
+    unlink(path); // The mapping outlives the file name
+    BENCH_CHECK(EventGenerator_Init() == pdPASS, "generator init");
+    updates = Test_PlayTimer(MAX_CALLS);
+
+    Test_CheckPosted(replayImage);
+    BENCH_CHECK(!Test_TimerRunning() && updates == postedCount, "%u timer updates for %u calls, timer %s", updates,
+                postedCount, Test_TimerRunning() ? "running" : "stopped");
+    printf("round trip: %u words dumped, mapped from a file and replayed, %u calls, timer stopped at the end\n",
+           dumpTotal, postedCount);
+}
+
+static void Test_DeferredAtEnd(void)
+{
+    AdmissionStats_t stats;
+    TimeStamp_t lastCallUs;
+    uint32_t updates, i;
+
+    Test_Start(deferredImage, sizeof(deferredImage));
+    Admission_Publish(3, 5, 0); // 60% full, no idle unit: elevated, low-severity calls are deferred
+
+    // Both calls are generated; the last one is held back
+    updates = Test_PlayTimer(2);
+    BENCH_CHECK(updates == 2 && postedCount == 1, "%u updates, %u calls posted before the retries", updates, postedCount);
+    lastCallUs = simNowUs;
+
+    for (i = 0; i < DEFER_RETRIES; ++i)
+    {
+        BENCH_CHECK(Test_TimerRunning(), "timer stopped with a call still deferred");
+        BENCH_CHECK(TIM2->ARR + 1U == ADMISSION_DEFER_RETRY_US, "retry period %u us, expected %lu", TIM2->ARR + 1U,
+                    ADMISSION_DEFER_RETRY_US);
+        (void)Test_PlayTimer(1);
+    }
+    BENCH_CHECK(postedCount == 1, "deferred call posted while elevated");
+
+    // Pressure gone: the next retry admits it and the timer stops
+    Admission_Publish(0, 1, 1);
+    updates = Test_PlayTimer(MAX_CALLS);
+    Admission_GetStats(&stats);
+    BENCH_CHECK(updates == 1 && !Test_TimerRunning(), "%u updates after the call was admitted, timer %s", updates,
+                Test_TimerRunning() ? "running" : "stopped");
+    BENCH_CHECK(postedCount == 2 && posted[1].severity == EVENT_SEVERITY_LOW && stats.deferAdmitted == 1,
+                "deferred call not admitted on retry");
+    printf("deferred at end: held for %.0f ms (%u retries), then admitted, timer stopped\n",
+           (double)(simNowUs - lastCallUs) / 1e3, DEFER_RETRIES + 1U);
+}
+
+int main(void)
+{
+    Test_Replay();
+    Test_RoundTrip();
+    Test_DeferredAtEnd();
+    return 0;
+}
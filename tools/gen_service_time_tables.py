@@ -0,0 +1,201 @@
+#!/usr/bin/env python3
+"""
+@file gen_service_time_tables.py
+@brief Generates the per-department service-time inverse-CDF tables.
+
+Run by CMake at build time; writes a C file defining serviceTimeTables[]
+(see Core/Inc/service_time.h). Each table holds the quantile function of the
+department's on-scene time, in milliseconds, at SERVICE_TIME_TABLE_SIZE + 1
+evenly spaced probabilities. The firmware interpolates between neighbouring
+points, so a draw needs no floating point at all.
+
+Edit DEPARTMENTS below to change a distribution. Before writing, every table
+is checked against its distribution (mean and median of the interpolated
+table); generation fails if they drift by more than FIDELITY_TOLERANCE.
+The draws themselves are checked against the distributions by
+test_service_time_fidelity.py, run from the host build (test/host).
+
+Usage: gen_service_time_tables.py <output.c>
+
+@date October 15, 2026
+@author shayb
+"""
+
+import math
+import sys
+from statistics import NormalDist
+
+TABLE_BITS = 8                 # Must match SERVICE_TIME_TABLE_BITS in service_time.h
+TABLE_SIZE = 1 << TABLE_BITS
+TAIL_PROBABILITY = 0.99995     # The last point stands in for u = 1 (heavy tails are capped here)
+FIDELITY_TOLERANCE = 0.03      # Allowed relative error of the table mean and median
+
+# Per-department service-time distributions (milliseconds).
+#   lognormal: median, sigma (of the underlying normal)
+#   gamma:     shape k, scale theta (mean = k * theta)
+#   empirical: ascending (cumulative probability, ms) points, first at 0.0, last at 1.0
+DEPARTMENTS = [
+    ("DEPT_POLICE", "lognormal", {"median": 600.0, "sigma": 0.6}),
+    ("DEPT_AMBULANCE", "gamma", {"shape": 2.0, "scale": 450.0}),
+    ("DEPT_FIRE", "empirical", {"points": [
+        (0.00, 300.0), (0.20, 500.0), (0.50, 800.0), (0.80, 1300.0),
+        (0.95, 2500.0), (0.99, 4000.0), (1.00, 6000.0)]}),
+]
+
+
+# --- Distributions ---
+
+def lognormal_quantile(p, median, sigma):
+    return median * math.exp(sigma * NormalDist().inv_cdf(p))
+
+
+def lognormal_mean(median, sigma):
+    return median * math.exp(sigma * sigma / 2.0)
+
+
+def gamma_cdf(x, shape, scale):
+    """Regularized lower incomplete gamma P(shape, x / scale)."""
+    x = x / scale
+    if x <= 0.0:
+        return 0.0
+    log_prefix = shape * math.log(x) - x - math.lgamma(shape)
+    if x < shape + 1.0:
+        # Series expansion
+        term = total = 1.0 / shape
+        a = shape
+        while abs(term) > abs(total) * 1e-15:
+            a += 1.0
+            term *= x / a
+            total += term
+        return total * math.exp(log_prefix)
+    # Continued fraction (modified Lentz) for the upper tail
+    tiny = 1e-300
+    b = x + 1.0 - shape
+    c = 1.0 / tiny
+    d = 1.0 / b
+    h = d
+    for i in range(1, 1000):
+        an = -i * (i - shape)
+        b += 2.0
+        d = an * d + b
+        d = tiny if abs(d) < tiny else d
+        c = b + an / c
+        c = tiny if abs(c) < tiny else c
+        d = 1.0 / d
+        delta = d * c
+        h *= delta
+        if abs(delta - 1.0) < 1e-15:
+            break
+    return 1.0 - math.exp(log_prefix) * h
+
+
+def gamma_quantile(p, shape, scale):
+    lo, hi = 0.0, shape * scale
+    while gamma_cdf(hi, shape, scale) < p:
+        hi *= 2.0
+    for _ in range(200):
+        mid = (lo + hi) / 2.0
+        if gamma_cdf(mid, shape, scale) < p:
+            lo = mid
+        else:
+            hi = mid
+    return (lo + hi) / 2.0
+
+
+def empirical_quantile(p, points):
+    for (p0, x0), (p1, x1) in zip(points, points[1:]):
+        if p <= p1:
+            return x0 + (x1 - x0) * (p - p0) / (p1 - p0)
+    return points[-1][1]
+
+
+def empirical_mean(points):
+    return sum((p1 - p0) * (x0 + x1) / 2.0 for (p0, x0), (p1, x1) in zip(points, points[1:]))
+
+
+def quantile_function(kind, params):
+    if kind == "lognormal":
+        return lambda p: lognormal_quantile(p, params["median"], params["sigma"])
+    if kind == "gamma":
+        return lambda p: gamma_quantile(p, params["shape"], params["scale"])
+    if kind == "empirical":
+        return lambda p: empirical_quantile(p, params["points"])
+    raise ValueError("unknown distribution '%s'" % kind)
+
+
+def reference_mean(kind, params):
+    if kind == "lognormal":
+        return lognormal_mean(params["median"], params["sigma"])
+    if kind == "gamma":
+        return params["shape"] * params["scale"]
+    return empirical_mean(params["points"])
+
+
+# --- Table Construction ---
+
+def build_table(kind, params):
+    quantile = quantile_function(kind, params)
+    table = []
+    for i in range(TABLE_SIZE + 1):
+        p = i / TABLE_SIZE
+        if i == 0:
+            value = quantile(0.0) if kind == "empirical" else 0.0
+        elif i == TABLE_SIZE:
+            value = quantile(TAIL_PROBABILITY)
+        else:
+            value = quantile(p)
+        table.append(max(1, int(round(value))))
+    return table
+
+
+def check_fidelity(name, kind, params, table):
+    """Compares the distribution the firmware actually samples with the reference."""
+    table_mean = sum((a + b) / 2.0 for a, b in zip(table, table[1:])) / TABLE_SIZE
+    table_median = table[TABLE_SIZE // 2]
+    ref_mean = reference_mean(kind, params)
+    ref_median = quantile_function(kind, params)(0.5)
+    for label, got, want in (("mean", table_mean, ref_mean), ("median", table_median, ref_median)):
+        error = abs(got - want) / want
+        if error > FIDELITY_TOLERANCE:
+            sys.exit("%s: table %s %.1f ms deviates %.1f%% from %.1f ms" % (name, label, got, error * 100.0, want))
+    return table_mean
+
+
+def main():
+    if len(sys.argv) != 2:
+        sys.exit("usage: %s <output.c>" % sys.argv[0])
+
+    lines = [
+        "/* Generated by tools/gen_service_time_tables.py - do not edit. */",
+        "",
+        '#include "service_time.h"',
+        "",
+        "#if SERVICE_TIME_TABLE_BITS != %d" % TABLE_BITS,
+        '#error "service_time.h and gen_service_time_tables.py disagree on the table size"',
+        "#endif",
+        "",
+    ]
+    entries = []
+    for dept, kind, params in DEPARTMENTS:
+        table = build_table(kind, params)
+        if any(b < a for a, b in zip(table, table[1:])):
+            sys.exit("%s: quantile table is not monotonic" % dept)
+        mean = check_fidelity(dept, kind, params, table)
+        symbol = "quantile_%s" % dept.lower()
+        lines.append("static const uint32_t %s[SERVICE_TIME_TABLE_SIZE + 1] = {" % symbol)
+        for row in range(0, len(table), 12):
+            lines.append("    " + ", ".join("%u" % v for v in table[row:row + 12]) + ",")
+        lines.append("};")
+        lines.append("")
+        entries.append('    [%s] = {%s, "%s", %uU},' % (dept, symbol, kind, int(round(mean))))
+
+    lines.append("const ServiceTimeTable_t serviceTimeTables[DEPT_COUNT] = {")
+    lines.extend(entries)
+    lines.append("};")
+
+    with open(sys.argv[1], "w") as out:
+        out.write("\n".join(lines) + "\n")
+
+
+if __name__ == "__main__":
+    main()
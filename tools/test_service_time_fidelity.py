@@ -0,0 +1,130 @@
+#!/usr/bin/env python3
+"""
+@file test_service_time_fidelity.py
+@brief Checks the service times the firmware samples against their distributions.
+
+The generator only checks the table mean and median. This test draws
+SAMPLE_COUNT service times per department through the firmware's own
+ServiceTime_DrawMs (test/host/sample_service_time.c) and compares them with the
+lognormal, gamma and empirical targets in gen_service_time_tables.DEPARTMENTS:
+
+  - Kolmogorov-Smirnov distance to the reference CDF, below the 0.1% critical
+    value plus one table interval: interpolating between quantile points keeps
+    the sampled CDF exact at every point, so the table itself can only move it
+    by up to 1 / TABLE_SIZE;
+  - sample quantiles at QUANTILES: the reference CDF at each one must be
+    within the 0.1% sampling error of the quantile plus one table interval of
+    its probability. The tolerance is in probability, not milliseconds: in
+    a sparse tail one interval spans hundreds of milliseconds;
+  - the sample mean, within FIDELITY_TOLERANCE of the reference.
+
+Run by ctest in the host build (test/host).
+
+Usage: test_service_time_fidelity.py <sample_service_time executable>
+
+@date October 16, 2026
+@author shayb
+"""
+
+import bisect
+import math
+import os
+import subprocess
+import sys
+from statistics import NormalDist
+
+sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
+import gen_service_time_tables as gen  # noqa: E402
+
+SAMPLE_COUNT = 200000
+KS_CRITICAL = 1.95             # sqrt(-ln(0.001 / 2) / 2), 0.1% significance
+QUANTILE_Z = 3.29              # Normal two-sided 0.1% point, for one sample quantile
+QUANTILES = (0.10, 0.25, 0.50, 0.75, 0.90, 0.99)
+DEPARTMENT_IDS = {"DEPT_POLICE": 0, "DEPT_AMBULANCE": 1, "DEPT_FIRE": 2}  # Must match DepartmentId_t
+
+
+# --- Reference CDFs ---
+
+def lognormal_cdf(x, median, sigma):
+    return NormalDist(math.log(median), sigma).cdf(math.log(x)) if x > 0.0 else 0.0
+
+
+def empirical_cdf(x, points):
+    if x <= points[0][1]:
+        return 0.0
+    for (p0, x0), (p1, x1) in zip(points, points[1:]):
+        if x <= x1:
+            return p0 + (p1 - p0) * (x - x0) / (x1 - x0)
+    return 1.0
+
+
+def cdf_function(kind, params):
+    if kind == "lognormal":
+        return lambda x: lognormal_cdf(x, params["median"], params["sigma"])
+    if kind == "gamma":
+        return lambda x: gen.gamma_cdf(x, params["shape"], params["scale"])
+    if kind == "empirical":
+        return lambda x: empirical_cdf(x, params["points"])
+    raise ValueError("unknown distribution '%s'" % kind)
+
+
+# --- Checks ---
+
+def ks_distance(samples, cdf):
+    """KS distance of whole-millisecond samples: a draw of v ms covers [v, v + 1)."""
+    n = len(samples)
+    distance = 0.0
+    i = 0
+    while i < n:
+        value = samples[i]
+        j = bisect.bisect_right(samples, value, i)
+        distance = max(distance, abs(i / n - cdf(value)), abs(j / n - cdf(value + 1)))
+        i = j
+    return distance
+
+
+def check_department(dept, kind, params, sampler):
+    output = subprocess.run([sampler, str(DEPARTMENT_IDS[dept]), str(SAMPLE_COUNT)], check=True, capture_output=True, text=True).stdout
+    samples = sorted(int(line) for line in output.split())
+    if len(samples) != SAMPLE_COUNT:
+        return ["%s: expected %d samples, got %d" % (dept, SAMPLE_COUNT, len(samples))]
+
+    failures = []
+    quantile = gen.quantile_function(kind, params)
+    cdf = cdf_function(kind, params)
+    ks_limit = KS_CRITICAL / math.sqrt(SAMPLE_COUNT) + 1.0 / gen.TABLE_SIZE
+    distance = ks_distance(samples, cdf)
+    print("%-15s %-9s KS %.4f (limit %.4f)" % (dept, kind, distance, ks_limit))
+    if distance > ks_limit:
+        failures.append("%s: KS distance %.4f exceeds %.4f" % (dept, distance, ks_limit))
+
+    for p in QUANTILES:
+        got = samples[int(p * SAMPLE_COUNT)]
+        reached = cdf(got + 0.5)  # Middle of the millisecond the draw stands for
+        limit = QUANTILE_Z * math.sqrt(p * (1.0 - p) / SAMPLE_COUNT) + 1.0 / gen.TABLE_SIZE
+        print("    p%02d  %7u ms, reference %8.1f ms, reference CDF there %.4f" % (round(p * 100), got, quantile(p), reached))
+        if abs(reached - p) > limit:
+            failures.append("%s: sample p%02d %u ms sits at reference CDF %.4f" % (dept, round(p * 100), got, reached))
+
+    mean = sum(samples) / SAMPLE_COUNT
+    want = gen.reference_mean(kind, params)
+    error = abs(mean - want) / want
+    print("    mean %7.1f ms, reference %8.1f ms (%+.2f%%)" % (mean, want, 100.0 * (mean - want) / want))
+    if error > gen.FIDELITY_TOLERANCE:
+        failures.append("%s: sample mean %.1f ms deviates %.1f%% from %.1f ms" % (dept, mean, error * 100.0, want))
+    return failures
+
+
+def main():
+    if len(sys.argv) != 2:
+        sys.exit("usage: %s <sample_service_time executable>" % sys.argv[0])
+
+    failures = []
+    for dept, kind, params in gen.DEPARTMENTS:
+        failures.extend(check_department(dept, kind, params, sys.argv[1]))
+    if failures:
+        sys.exit("FAILED:\n  " + "\n  ".join(failures))
+
+
+if __name__ == "__main__":
+    main()